@@ -0,0 +1,255 @@
+#include "Analytics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace game {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kColumnMagic[8] = { 'P', 'R', 'G', 'C', 'O', 'L', '0', '1' };
+constexpr uint64_t kColumnAlign = 8;
+constexpr size_t kMaxDictEntries = 65536;  // subject codes are 16 bits
+
+uint64_t AlignUp(uint64_t offset) { return (offset + kColumnAlign - 1) & ~(kColumnAlign - 1); }
+
+int64_t NowUs() {
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Parses "progress-<n>.col"; false for anything else.
+bool ParseSequence(const std::string& name, uint64_t& out) {
+    const std::string prefix = "progress-";
+    const std::string ext = ".col";
+    if (name.size() <= prefix.size() + ext.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - ext.size(), ext.size(), ext) != 0)
+        return false;
+    uint64_t value = 0;
+    for (size_t i = prefix.size(); i < name.size() - ext.size(); ++i) {
+        if (name[i] < '0' || name[i] > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(name[i] - '0');
+    }
+    out = value;
+    return true;
+}
+
+std::vector<std::pair<uint64_t, std::string>> ScanDirectory(const std::string& directory) {
+    std::vector<std::pair<uint64_t, std::string>> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        uint64_t seq = 0;
+        if (ParseSequence(entry.path().filename().string(), seq)) files.emplace_back(seq, entry.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+template <typename T>
+bool WriteColumn(std::FILE* file, uint64_t offset, const std::vector<T>& column) {
+    static const char kZeros[kColumnAlign] = {};
+    const long pos = std::ftell(file);
+    if (pos < 0 || static_cast<uint64_t>(pos) > offset) return false;
+    const size_t pad = static_cast<size_t>(offset - static_cast<uint64_t>(pos));
+    if (pad != 0 && std::fwrite(kZeros, 1, pad, file) != pad) return false;
+    return column.empty() || std::fwrite(column.data(), sizeof(T), column.size(), file) == column.size();
+}
+
+template <typename T>
+bool ColumnFits(const MappedFile& file, uint64_t offset, uint64_t count) {
+    return offset % kColumnAlign == 0 && offset <= file.Size() && count <= (file.Size() - offset) / sizeof(T);
+}
+
+} // namespace
+
+bool ProgressionAnalytics::Open(const AnalyticsOptions& options) {
+    Close();
+    options_ = options;
+    options_.producers = std::max<size_t>(options_.producers, 1);
+    options_.rowsPerFile = std::max<uint32_t>(options_.rowsPerFile, 1);
+    std::error_code ec;
+    fs::create_directories(options_.directory, ec);
+    if (ec) return false;
+
+    const auto existing = ScanDirectory(options_.directory);
+    nextFile_ = existing.empty() ? 0 : existing.back().first + 1;
+
+    rings_.clear();
+    for (size_t i = 0; i < options_.producers; ++i)
+        rings_.push_back(std::make_unique<SpscRing<ProgressionEvent>>(options_.ringCapacity));
+    drained_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    files_.store(0, std::memory_order_relaxed);
+    stop_ = false;
+    writer_ = std::thread(&ProgressionAnalytics::WriterLoop, this);
+    return true;
+}
+
+void ProgressionAnalytics::Close() {
+    if (!writer_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    DrainRings();
+    Rotate();
+    rings_.clear();
+}
+
+bool ProgressionAnalytics::Record(size_t producer, ProgressionKind kind, PlayerId playerId, uint32_t subject,
+                                  uint8_t state, int32_t value) {
+    ProgressionEvent event;
+    event.timeUs = NowUs();
+    event.playerId = playerId;
+    event.subject = subject;
+    event.value = value;
+    event.kind = kind;
+    event.state = state;
+    if (producer < rings_.size() && rings_[producer]->TryPush(event)) return true;
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+AnalyticsStats ProgressionAnalytics::Stats() const {
+    AnalyticsStats stats;
+    stats.drained = drained_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.files = files_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ProgressionAnalytics::WriterLoop() {
+    const int64_t maxAgeUs = int64_t{ options_.fileSeconds } * 1000000;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(options_.drainMs), [&] { return stop_; });
+        if (stop_) break;
+        lock.unlock();
+        DrainRings();
+        if (!timeUs_.empty() && NowUs() - fileStartUs_ >= maxAgeUs) Rotate();
+        lock.lock();
+    }
+}
+
+void ProgressionAnalytics::DrainRings() {
+    uint64_t count = 0;
+    for (auto& ring : rings_)
+        count += ring->PopAll([this](const ProgressionEvent& event) { Append(event); });
+    drained_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void ProgressionAnalytics::Append(const ProgressionEvent& event) {
+    const uint64_t key = (uint64_t{ static_cast<uint8_t>(event.kind) } << 32) | event.subject;
+    auto it = dictIndex_.find(key);
+    if (it == dictIndex_.end()) {
+        if (dict_.size() == kMaxDictEntries) Rotate();
+        AnalyticsDictEntry entry;
+        entry.subject = event.subject;
+        entry.kind = event.kind;
+        it = dictIndex_.emplace(key, static_cast<uint16_t>(dict_.size())).first;
+        dict_.push_back(entry);
+    }
+    if (timeUs_.empty()) fileStartUs_ = NowUs();
+    timeUs_.push_back(event.timeUs);
+    players_.push_back(event.playerId);
+    values_.push_back(event.value);
+    subjects_.push_back(it->second);
+    states_.push_back(event.state);
+    if (timeUs_.size() >= options_.rowsPerFile) Rotate();
+}
+
+void ProgressionAnalytics::Rotate() {
+    if (!timeUs_.empty()) {
+        AnalyticsFileHeader header;
+        header.rowCount = static_cast<uint32_t>(timeUs_.size());
+        header.dictCount = static_cast<uint32_t>(dict_.size());
+        header.firstTimeUs = *std::min_element(timeUs_.begin(), timeUs_.end());
+        header.lastTimeUs = *std::max_element(timeUs_.begin(), timeUs_.end());
+        header.dictOffset = AlignUp(sizeof(header));
+        header.timeOffset = AlignUp(header.dictOffset + dict_.size() * sizeof(AnalyticsDictEntry));
+        header.playerOffset = AlignUp(header.timeOffset + timeUs_.size() * sizeof(int64_t));
+        header.valueOffset = AlignUp(header.playerOffset + players_.size() * sizeof(PlayerId));
+        header.subjectOffset = AlignUp(header.valueOffset + values_.size() * sizeof(int32_t));
+        header.stateOffset = AlignUp(header.subjectOffset + subjects_.size() * sizeof(uint16_t));
+        header.fileSize = header.stateOffset + states_.size();
+
+        // Written aside and renamed, so a reader never maps a partial file.
+        const std::string path =
+            (fs::path(options_.directory) / ("progress-" + std::to_string(nextFile_++) + ".col")).string();
+        const std::string temp = path + ".tmp";
+        bool ok = false;
+        if (std::FILE* file = std::fopen(temp.c_str(), "wb")) {
+            ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 WriteColumn(file, header.dictOffset, dict_) && WriteColumn(file, header.timeOffset, timeUs_) &&
+                 WriteColumn(file, header.playerOffset, players_) && WriteColumn(file, header.valueOffset, values_) &&
+                 WriteColumn(file, header.subjectOffset, subjects_) && WriteColumn(file, header.stateOffset, states_);
+            ok = std::fclose(file) == 0 && ok;
+            std::error_code ec;
+            if (ok) fs::rename(temp, path, ec);
+            if (!ok || ec) {
+                std::remove(temp.c_str());
+                ok = false;
+            }
+        }
+        if (ok) {
+            written_.fetch_add(timeUs_.size(), std::memory_order_relaxed);
+            files_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    // Cleared either way (capacity kept); a file that failed to write is lost.
+    timeUs_.clear();
+    players_.clear();
+    values_.clear();
+    subjects_.clear();
+    states_.clear();
+    dict_.clear();
+    dictIndex_.clear();
+}
+
+bool ProgressionColumns::Open(const std::string& path) {
+    header_ = AnalyticsFileHeader{};
+    if (!file_.Open(path) || file_.Size() < sizeof(AnalyticsFileHeader)) {
+        file_.Close();
+        return false;
+    }
+    AnalyticsFileHeader header;
+    std::memcpy(&header, file_.Data(), sizeof(header));
+    const bool valid = std::memcmp(header.magic, kColumnMagic, sizeof(kColumnMagic)) == 0 &&
+                       header.fileSize == file_.Size() && header.dictCount <= kMaxDictEntries &&
+                       ColumnFits<AnalyticsDictEntry>(file_, header.dictOffset, header.dictCount) &&
+                       ColumnFits<int64_t>(file_, header.timeOffset, header.rowCount) &&
+                       ColumnFits<PlayerId>(file_, header.playerOffset, header.rowCount) &&
+                       ColumnFits<int32_t>(file_, header.valueOffset, header.rowCount) &&
+                       ColumnFits<uint16_t>(file_, header.subjectOffset, header.rowCount) &&
+                       ColumnFits<uint8_t>(file_, header.stateOffset, header.rowCount);
+    if (!valid) {
+        file_.Close();
+        return false;
+    }
+    header_ = header;
+    for (uint16_t code : Subjects()) {
+        if (code >= header_.dictCount) {
+            header_ = AnalyticsFileHeader{};
+            file_.Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> ListProgressionFiles(const std::string& directory) {
+    std::vector<std::string> out;
+    for (auto& [seq, path] : ScanDirectory(directory)) out.push_back(std::move(path));
+    return out;
+}
+
+} // namespace game
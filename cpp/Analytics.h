@@ -0,0 +1,172 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "MappedFile.h"
+#include "Span.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+enum class ProgressionKind : uint8_t {
+    Quest,           // state = QuestState reported by QuestSystem (Available after InProgress = abandoned)
+    Mission,         // state = MissionState, value = objective index the mission was on
+    WeaponPrestige   // subject = WeaponId, value = new prestige level
+};
+
+struct ProgressionEvent {
+    int64_t timeUs = 0;  // system clock, stamped by Record
+    PlayerId playerId = 0;
+    uint32_t subject = 0;  // QuestId, MissionId or WeaponId
+    int32_t value = 0;
+    ProgressionKind kind = ProgressionKind::Quest;
+    uint8_t state = 0;
+};
+
+// Column file records. A file is a header, the subject dictionary and one
+// array per column (each 8-byte aligned, host byte order); row i of every
+// column is one event.
+struct AnalyticsDictEntry {
+    uint32_t subject = 0;
+    ProgressionKind kind = ProgressionKind::Quest;
+    uint8_t reserved[3] = {};
+};
+static_assert(sizeof(AnalyticsDictEntry) == 8, "AnalyticsDictEntry is written to disk as-is");
+
+struct AnalyticsFileHeader {
+    char magic[8] = { 'P', 'R', 'G', 'C', 'O', 'L', '0', '1' };
+    uint32_t rowCount = 0;
+    uint32_t dictCount = 0;
+    int64_t firstTimeUs = 0;
+    int64_t lastTimeUs = 0;
+    uint64_t dictOffset = 0;     // AnalyticsDictEntry[dictCount]
+    uint64_t timeOffset = 0;     // int64_t[rowCount]
+    uint64_t playerOffset = 0;   // PlayerId[rowCount]
+    uint64_t valueOffset = 0;    // int32_t[rowCount]
+    uint64_t subjectOffset = 0;  // uint16_t[rowCount], dictionary index
+    uint64_t stateOffset = 0;    // uint8_t[rowCount]
+    uint64_t fileSize = 0;
+};
+static_assert(sizeof(AnalyticsFileHeader) == 88, "AnalyticsFileHeader is written to disk as-is");
+
+struct AnalyticsOptions {
+    std::string directory;
+    size_t producers = 1;             // threads calling Record, one ring each
+    size_t ringCapacity = 1 << 16;    // events per producer ring
+    uint32_t drainMs = 10;            // writer thread wake-up interval
+    uint32_t rowsPerFile = 1 << 20;   // rotate after this many events...
+    uint32_t fileSeconds = 60;        // ...or once the open file is this old
+};
+
+struct AnalyticsStats {
+    uint64_t drained = 0;  // events taken off the rings
+    uint64_t dropped = 0;  // events lost to a full ring
+    uint64_t written = 0;  // events in finished files
+    uint64_t files = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Progression event stream for offline funnel analysis. Each producer thread
+// owns one SPSC ring (by index), so Record is a clock read and a ring push:
+// no lock, no allocation, and a full ring drops the event rather than
+// stalling the sim. A writer thread drains the rings into column buffers
+// and writes them out as progress-<n>.col files (ProgressionColumns reads
+// them), rotating on row count or age. Subjects are dictionary-coded per
+// file, so a row costs 19 bytes.
+//
+// Events from one producer keep their order; different producers are only
+// ordered by timestamp. Files appear whole (written aside, then renamed).
+// ---------------------------------------------------------------------------
+class ProgressionAnalytics {
+public:
+    ProgressionAnalytics() = default;
+    ~ProgressionAnalytics() { Close(); }
+
+    ProgressionAnalytics(const ProgressionAnalytics&) = delete;
+    ProgressionAnalytics& operator=(const ProgressionAnalytics&) = delete;
+
+    // Creates the directory if needed and starts the writer thread; new
+    // files continue the numbering found there. Not thread-safe: producers
+    // must not run during Open or Close.
+    bool Open(const AnalyticsOptions& options);
+    // Drains the rings, writes the last (partial) file and stops the writer.
+    void Close();
+    bool IsOpen() const { return writer_.joinable(); }
+    size_t ProducerCount() const { return rings_.size(); }
+
+    // Producer thread `producer` only. False (and counted as dropped) when
+    // the ring is full, the index is invalid or the stream is closed.
+    bool Record(size_t producer, ProgressionKind kind, PlayerId playerId, uint32_t subject, uint8_t state,
+                int32_t value = 0);
+
+    AnalyticsStats Stats() const;
+
+private:
+    void WriterLoop();
+    void DrainRings();
+    void Append(const ProgressionEvent& event);
+    void Rotate();  // writes the buffered rows as the next file
+
+    AnalyticsOptions options_;
+    std::vector<std::unique_ptr<SpscRing<ProgressionEvent>>> rings_;
+    std::atomic<uint64_t> drained_{ 0 };
+    std::atomic<uint64_t> dropped_{ 0 };
+    std::atomic<uint64_t> written_{ 0 };
+    std::atomic<uint64_t> files_{ 0 };
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;  // guarded by mutex_
+    std::thread writer_;
+
+    // Writer thread only: the open file's columns.
+    uint64_t nextFile_ = 0;
+    int64_t fileStartUs_ = 0;
+    std::vector<int64_t> timeUs_;
+    std::vector<PlayerId> players_;
+    std::vector<int32_t> values_;
+    std::vector<uint16_t> subjects_;
+    std::vector<uint8_t> states_;
+    std::vector<AnalyticsDictEntry> dict_;
+    std::unordered_map<uint64_t, uint16_t> dictIndex_;  // kind << 32 | subject
+};
+
+// Read-only view of one column file, mapped and validated on Open.
+class ProgressionColumns {
+public:
+    // False if the file is missing, not a column file or has out-of-range
+    // columns or dictionary codes.
+    bool Open(const std::string& path);
+
+    uint32_t RowCount() const { return header_.rowCount; }
+    int64_t FirstTimeUs() const { return header_.firstTimeUs; }
+    int64_t LastTimeUs() const { return header_.lastTimeUs; }
+    Span<const AnalyticsDictEntry> Dictionary() const { return Column<AnalyticsDictEntry>(header_.dictOffset, header_.dictCount); }
+    Span<const int64_t> TimeUs() const { return Column<int64_t>(header_.timeOffset, header_.rowCount); }
+    Span<const PlayerId> Players() const { return Column<PlayerId>(header_.playerOffset, header_.rowCount); }
+    Span<const int32_t> Values() const { return Column<int32_t>(header_.valueOffset, header_.rowCount); }
+    Span<const uint16_t> Subjects() const { return Column<uint16_t>(header_.subjectOffset, header_.rowCount); }
+    Span<const uint8_t> States() const { return Column<uint8_t>(header_.stateOffset, header_.rowCount); }
+
+private:
+    template <typename T>
+    Span<const T> Column(uint64_t offset, uint32_t count) const {
+        return Span<const T>(reinterpret_cast<const T*>(file_.Data() + offset), count);
+    }
+
+    MappedFile file_;
+    AnalyticsFileHeader header_;
+};
+
+// Column files in a directory, oldest first.
+std::vector<std::string> ListProgressionFiles(const std::string& directory);
+
+} // namespace game
@@ -0,0 +1,168 @@
+/**
+ * Virtual Sim — progression analytics report
+ * Reads the column files ProgressionAnalytics writes (progress-<n>.col,
+ * oldest first) and prints funnel aggregates: per quest, starts,
+ * completions, abandons and start-to-complete times; per mission, starts,
+ * successes, failures and the objective each failure happened on; per
+ * weapon, prestiges by level. Unreadable files are reported and skipped.
+ *
+ * Usage: analytics_report <directory>
+ */
+
+#include "Analytics.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace game;
+
+namespace {
+
+struct QuestFunnel {
+    uint64_t started = 0;
+    uint64_t completed = 0;
+    uint64_t abandoned = 0;
+    std::vector<int64_t> completeUs;  // start-to-complete, for runs whose start was seen
+};
+
+struct MissionFunnel {
+    uint64_t started = 0;
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    std::map<int32_t, uint64_t> failedAt;  // objective index -> failures
+};
+
+uint64_t RunKey(PlayerId playerId, uint32_t subject) { return (uint64_t{ playerId } << 32) | subject; }
+
+double Percentile(std::vector<int64_t>& values, double p) {
+    if (values.empty()) return 0.0;
+    const size_t k = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+    return static_cast<double>(values[k]) / 1e6;
+}
+
+double Rate(uint64_t part, uint64_t whole) { return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: analytics_report <directory>\n");
+        return 2;
+    }
+    const std::vector<std::string> paths = ListProgressionFiles(argv[1]);
+    if (paths.empty()) {
+        std::fprintf(stderr, "analytics_report: no progress-<n>.col files in %s\n", argv[1]);
+        return 1;
+    }
+
+    std::map<QuestId, QuestFunnel> quests;
+    std::map<MissionId, MissionFunnel> missions;
+    std::map<uint32_t, std::map<int32_t, uint64_t>> prestiges;  // weapon -> level -> count
+    std::unordered_map<uint64_t, int64_t> questStarts;           // (player, quest) -> start time
+    uint64_t rows = 0;
+    int64_t firstUs = INT64_MAX;
+    int64_t lastUs = INT64_MIN;
+
+    for (const std::string& path : paths) {
+        ProgressionColumns file;
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "analytics_report: skipping unreadable %s\n", path.c_str());
+            continue;
+        }
+        rows += file.RowCount();
+        if (file.RowCount() != 0) {
+            firstUs = std::min(firstUs, file.FirstTimeUs());
+            lastUs = std::max(lastUs, file.LastTimeUs());
+        }
+        const Span<const AnalyticsDictEntry> dict = file.Dictionary();
+        const Span<const int64_t> timeUs = file.TimeUs();
+        const Span<const PlayerId> players = file.Players();
+        const Span<const int32_t> values = file.Values();
+        const Span<const uint16_t> subjects = file.Subjects();
+        const Span<const uint8_t> states = file.States();
+        for (uint32_t row = 0; row < file.RowCount(); ++row) {
+            const AnalyticsDictEntry& entry = dict[subjects[row]];
+            switch (entry.kind) {
+            case ProgressionKind::Quest: {
+                QuestFunnel& funnel = quests[entry.subject];
+                const uint64_t key = RunKey(players[row], entry.subject);
+                switch (static_cast<QuestState>(states[row])) {
+                case QuestState::InProgress:
+                    ++funnel.started;
+                    questStarts[key] = timeUs[row];
+                    break;
+                case QuestState::Completed: {
+                    ++funnel.completed;
+                    auto it = questStarts.find(key);
+                    if (it != questStarts.end()) {
+                        funnel.completeUs.push_back(timeUs[row] - it->second);
+                        questStarts.erase(it);
+                    }
+                    break;
+                }
+                case QuestState::Available:  // reported on abandon
+                    ++funnel.abandoned;
+                    questStarts.erase(key);
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            case ProgressionKind::Mission: {
+                MissionFunnel& funnel = missions[entry.subject];
+                switch (static_cast<MissionState>(states[row])) {
+                case MissionState::Active: ++funnel.started; break;
+                case MissionState::Success: ++funnel.succeeded; break;
+                case MissionState::Failed:
+                    ++funnel.failed;
+                    ++funnel.failedAt[values[row]];
+                    break;
+                default: break;
+                }
+                break;
+            }
+            case ProgressionKind::WeaponPrestige:
+                ++prestiges[entry.subject][values[row]];
+                break;
+            }
+        }
+    }
+
+    std::printf("%zu files, %llu events", paths.size(), static_cast<unsigned long long>(rows));
+    if (rows != 0) std::printf(" over %.1f s", static_cast<double>(lastUs - firstUs) / 1e6);
+    std::printf("\n");
+
+    if (!quests.empty()) {
+        std::printf("\nquest      started  completed  abandoned  abandon%%  complete p50 s  p90 s\n");
+        for (auto& [id, f] : quests)
+            std::printf("%-9u %8llu %10llu %10llu %8.1f %15.1f %6.1f\n", id,
+                        static_cast<unsigned long long>(f.started), static_cast<unsigned long long>(f.completed),
+                        static_cast<unsigned long long>(f.abandoned), Rate(f.abandoned, f.started),
+                        Percentile(f.completeUs, 0.5), Percentile(f.completeUs, 0.9));
+    }
+    if (!missions.empty()) {
+        std::printf("\nmission    started  succeeded   failed  fail%%  failed at objective (index:count)\n");
+        for (const auto& [id, f] : missions) {
+            std::printf("%-9u %8llu %10llu %8llu %6.1f ", id, static_cast<unsigned long long>(f.started),
+                        static_cast<unsigned long long>(f.succeeded), static_cast<unsigned long long>(f.failed),
+                        Rate(f.failed, f.started));
+            for (const auto& [objective, count] : f.failedAt)
+                std::printf(" %d:%llu", objective, static_cast<unsigned long long>(count));
+            std::printf("\n");
+        }
+    }
+    if (!prestiges.empty()) {
+        std::printf("\nweapon     prestiges by level (level:count)\n");
+        for (const auto& [id, levels] : prestiges) {
+            std::printf("%-9u", id);
+            for (const auto& [level, count] : levels)
+                std::printf(" %d:%llu", level, static_cast<unsigned long long>(count));
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
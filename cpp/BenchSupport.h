@@ -0,0 +1,57 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// Shared measurement helpers for the benchmark executables: a counting
+// replacement of the global operator new/delete and the process's peak
+// resident memory. The operator replacements are definitions, so include
+// this from exactly one translation unit of each benchmark.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ---- Allocation counting (global operator new replacement) ----
+
+inline std::atomic<uint64_t> g_allocCount{ 0 };
+inline std::atomic<uint64_t> g_allocBytes{ 0 };
+
+void* operator new(std::size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+inline uint64_t PeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return static_cast<uint64_t>(pmc.PeakWorkingSetSize / 1024);
+#else
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(ru.ru_maxrss) / 1024;  // bytes on macOS
+#else
+    return static_cast<uint64_t>(ru.ru_maxrss);          // KiB on Linux
+#endif
+#endif
+}
@@ -0,0 +1,300 @@
+#include "BotDriver.h"
+#include "QuestData.h"
+#include <chrono>
+#include <ctime>
+#include <memory>
+
+namespace game {
+
+namespace {
+
+constexpr float kBotRespawnSec = 5.0f;
+constexpr QuestId kBotKillQuests[] = { 1, 18 };  // "First Blood", "Close Quarters"
+constexpr MissionId kBotMissionId = 1;
+
+int TeamIndex(Team team) { return static_cast<int>(team) - 1; }
+
+Team EnemyOf(Team team) { return team == Team::Alpha ? Team::Bravo : Team::Alpha; }
+
+} // namespace
+
+void BotMatchStats::Accumulate(const BotMatchStats& other) {
+    ticks += other.ticks;
+    kills += other.kills;
+    pointMoves += other.pointMoves;
+    flagPickups += other.flagPickups;
+    flagCaptures += other.flagCaptures;
+    bombPlants += other.bombPlants;
+    bombDefuses += other.bombDefuses;
+    matchesCompleted += other.matchesCompleted;
+}
+
+BotMatch::BotMatch(GameMode mode, int botCount, PlayerId firstPlayerId, uint32_t seed, BotProfile profile)
+    : mode_(mode), profile_(profile), rng_(seed) {
+    RegisterAllQuests(server_.Quests());
+
+    MissionDefinition sweep;
+    sweep.id = kBotMissionId;
+    sweep.title = "Sweep";
+    sweep.description = "Eliminate 25 enemies.";
+    sweep.objectives.push_back({ 1, MissionObjectiveType::EliminateAll, 0, 25, "enemy", 0.0f, false });
+    server_.Missions().RegisterMission(std::move(sweep));
+
+    bots_.resize(static_cast<size_t>(botCount));
+    for (int i = 0; i < botCount; ++i) {
+        ScriptedBot& bot = bots_[static_cast<size_t>(i)];
+        bot.id = firstPlayerId + static_cast<PlayerId>(i);
+        bot.team = (i % 2 == 0) ? Team::Alpha : Team::Bravo;
+        server_.AddPlayer(bot.id, bot.team);
+        for (QuestId qid : kBotKillQuests)
+            server_.Quests().StartQuest(bot.id, qid);
+        server_.Missions().StartMission(bot.id, kBotMissionId);
+    }
+    server_.SetGameMode(mode_);
+}
+
+bool BotMatch::Chance(float perSec, float deltaSec) {
+    return unit_(rng_) < perSec * deltaSec;
+}
+
+ScriptedBot* BotMatch::PickEnemy(Team team) {
+    if (bots_.empty()) return nullptr;
+    std::uniform_int_distribution<size_t> pick(0, bots_.size() - 1);
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        ScriptedBot& bot = bots_[pick(rng_)];
+        if (bot.alive && bot.team != team) return &bot;
+    }
+    return nullptr;
+}
+
+void BotMatch::Emit(const CombatEvent& ev) {
+    server_.IngestCombatEvents(Span<const CombatEvent>(&ev, 1));
+}
+
+void BotMatch::Kill(ScriptedBot& killer, ScriptedBot& victim) {
+    victim.alive = false;
+    victim.respawnSec = kBotRespawnSec;
+    stats_.kills++;
+
+    if (profile_.batchCombatEvents) {
+        pendingKills_.push_back({ CombatEventType::Kill, killer.id, victim.id, sym::kEnemy });
+    } else {
+        if (mode_ == GameMode::TeamDeathmatch)
+            server_.TDM().OnKill(killer.id, victim.id);
+        else if (mode_ == GameMode::SearchAndDestroy)
+            server_.SND().OnPlayerKilled(victim.id);
+        server_.Quests().NotifyKill(killer.id, sym::kEnemy);
+        server_.Missions().NotifyKill(killer.id, sym::kEnemy);
+    }
+
+    switch (mode_) {
+    case GameMode::Domination:
+        server_.Dom().SetPlayerOnPoint(victim.id, -1);
+        break;
+    case GameMode::CaptureTheFlag:
+        server_.CTF().DropFlag(victim.id);
+        break;
+    default:
+        break;
+    }
+}
+
+void BotMatch::TickKills(float deltaSec) {
+    for (auto& bot : bots_) {
+        if (!bot.alive) {
+            // SnD has no respawns; everyone comes back at the next StartRound.
+            if (mode_ == GameMode::SearchAndDestroy) continue;
+            bot.respawnSec -= deltaSec;
+            if (bot.respawnSec <= 0.0f) bot.alive = true;
+            continue;
+        }
+        if (!Chance(profile_.killsPerSec, deltaSec)) continue;
+        if (ScriptedBot* victim = PickEnemy(bot.team))
+            Kill(bot, *victim);
+    }
+}
+
+void BotMatch::TickDomination(float deltaSec) {
+    int pointCount = static_cast<int>(server_.Dom().GetState().points.size());
+    std::uniform_int_distribution<int> pick(-1, pointCount - 1);
+    for (const auto& bot : bots_) {
+        if (!bot.alive || !Chance(profile_.pointMovesPerSec, deltaSec)) continue;
+        server_.Dom().SetPlayerOnPoint(bot.id, pick(rng_));
+        stats_.pointMoves++;
+    }
+}
+
+void BotMatch::TickCTF(float deltaSec) {
+    CaptureTheFlag& ctf = server_.CTF();
+
+    for (Team team : { Team::Alpha, Team::Bravo }) {
+        const FlagState& flag = ctf.GetState().flags.at(team);
+        float& returnSec = flagReturnSec_[TeamIndex(team)];
+        if (flag.atBase || flag.carrierId != 0) {
+            returnSec = 0.0f;
+            continue;
+        }
+        returnSec += deltaSec;
+        if (returnSec >= profile_.flagReturnSec) {
+            ctf.ReturnFlag(team);
+            returnSec = 0.0f;
+        }
+    }
+
+    for (auto& bot : bots_) {
+        if (!bot.alive) continue;
+        Team enemy = EnemyOf(bot.team);
+        const FlagState& enemyFlag = ctf.GetState().flags.at(enemy);
+
+        if (enemyFlag.carrierId == bot.id) {
+            bot.actionSec -= deltaSec;
+            if (bot.actionSec > 0.0f) continue;
+            int32_t before = ctf.GetState().teamScores.at(bot.team);
+            if (profile_.batchCombatEvents)
+                Emit({ CombatEventType::FlagCapture, bot.id, 0, {} });
+            else
+                ctf.CaptureFlag(bot.id);
+            if (ctf.GetState().teamScores.at(bot.team) != before)
+                stats_.flagCaptures++;
+            else
+                bot.actionSec = 1.0f;  // own flag is away; hold and retry
+            continue;
+        }
+
+        if (enemyFlag.atBase && Chance(profile_.flagGrabsPerSec, deltaSec)) {
+            ctf.PickupFlag(bot.id, enemy);
+            if (ctf.GetState().flags.at(enemy).carrierId == bot.id) {
+                bot.actionSec = profile_.flagRunSec;
+                stats_.flagPickups++;
+            }
+        }
+    }
+}
+
+void BotMatch::TickSND(float deltaSec) {
+    SearchAndDestroy& snd = server_.SND();
+    const SndRoundState& st = snd.GetState();
+
+    if (st.roundNumber == 0 || st.phase == SndPhase::PostRound) {
+        if (st.roundNumber != 0 && snd.IsMatchOver()) return;
+        snd.StartRound();
+        for (auto& bot : bots_) bot.alive = true;
+        sndRoundSec_ = 0.0f;
+        return;
+    }
+
+    if (st.phase == SndPhase::RoundActive) {
+        sndRoundSec_ += deltaSec;
+        if (st.bombCarrierId == 0) {
+            for (const auto& bot : bots_) {
+                if (bot.alive && bot.team == Team::Alpha) {
+                    snd.OnBombPickedUp(bot.id);
+                    break;
+                }
+            }
+        }
+        if (st.bombCarrierId != 0 && sndRoundSec_ >= profile_.plantAfterSec) {
+            if (profile_.batchCombatEvents)
+                Emit({ CombatEventType::BombPlant, st.bombCarrierId, 0, {} });
+            else
+                snd.OnBombPlanted(st.bombCarrierId);
+            stats_.bombPlants++;
+            sndRoundSec_ = 0.0f;
+            sndDefuseAttempt_ = unit_(rng_) < profile_.defuseChance;
+        }
+        return;
+    }
+
+    if (st.phase == SndPhase::BombPlanted && sndDefuseAttempt_) {
+        sndRoundSec_ += deltaSec;
+        if (sndRoundSec_ < profile_.defuseAfterSec) return;
+        for (const auto& bot : bots_) {
+            if (bot.alive && bot.team == Team::Bravo) {
+                if (profile_.batchCombatEvents)
+                    Emit({ CombatEventType::BombDefuse, bot.id, 0, {} });
+                else
+                    snd.OnBombDefused(bot.id);
+                stats_.bombDefuses++;
+                break;
+            }
+        }
+        sndDefuseAttempt_ = false;
+    }
+}
+
+bool BotMatch::IsMatchOver() const {
+    switch (mode_) {
+    case GameMode::TeamDeathmatch:   return server_.TDM().IsGameOver();
+    case GameMode::Domination:       return server_.Dom().IsGameOver();
+    case GameMode::CaptureTheFlag:   return server_.CTF().IsGameOver();
+    case GameMode::SearchAndDestroy: return server_.SND().GetState().roundNumber != 0 && server_.SND().IsMatchOver();
+    default:                         return false;
+    }
+}
+
+void BotMatch::RestartMatch() {
+    stats_.matchesCompleted++;
+    server_.SetGameMode(GameMode::None);
+    server_.SetGameMode(mode_);
+    for (auto& bot : bots_) {
+        bot.alive = true;
+        bot.actionSec = 0.0f;
+    }
+    flagReturnSec_[0] = flagReturnSec_[1] = 0.0f;
+    sndRoundSec_ = 0.0f;
+    sndDefuseAttempt_ = false;
+}
+
+void BotMatch::Tick(float deltaSec) {
+    bool sndLive = mode_ != GameMode::SearchAndDestroy ||
+                   server_.SND().GetState().phase == SndPhase::RoundActive ||
+                   server_.SND().GetState().phase == SndPhase::BombPlanted;
+    if (sndLive)
+        TickKills(deltaSec);
+    if (!pendingKills_.empty()) {
+        server_.IngestCombatEvents(pendingKills_);
+        pendingKills_.clear();
+    }
+
+    switch (mode_) {
+    case GameMode::Domination:       TickDomination(deltaSec); break;
+    case GameMode::CaptureTheFlag:   TickCTF(deltaSec); break;
+    case GameMode::SearchAndDestroy: TickSND(deltaSec); break;
+    default: break;
+    }
+
+    server_.Tick(deltaSec);
+    stats_.ticks++;
+
+    if (IsMatchOver())
+        RestartMatch();
+}
+
+BotLoadResult RunBotLoad(GameMode mode, int matches, int botsPerMatch, int ticks,
+                         float tickSec, uint32_t seed, const BotProfile& profile) {
+    std::vector<std::unique_ptr<BotMatch>> live;
+    live.reserve(static_cast<size_t>(matches));
+    for (int m = 0; m < matches; ++m) {
+        PlayerId first = 1 + static_cast<PlayerId>(m * botsPerMatch);
+        live.push_back(std::make_unique<BotMatch>(mode, botsPerMatch, first, seed + static_cast<uint32_t>(m), profile));
+    }
+
+    std::clock_t cpuStart = std::clock();
+    auto wallStart = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t)
+        for (auto& match : live)
+            match->Tick(tickSec);
+    auto wallEnd = std::chrono::steady_clock::now();
+    std::clock_t cpuEnd = std::clock();
+
+    BotLoadResult result;
+    result.matches = matches;
+    result.matchTicks = static_cast<uint64_t>(matches) * static_cast<uint64_t>(ticks);
+    result.wallSec = std::chrono::duration<double>(wallEnd - wallStart).count();
+    result.cpuSec = static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+    for (const auto& match : live)
+        result.totals.Accumulate(match->Stats());
+    return result;
+}
+
+} // namespace game
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "GameServer.h"
+#include "GameTypes.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Headless scripted bots for load-testing the multiplayer modes.
+// Each BotMatch owns a GameServer and drives it with the same calls a real
+// session would make: kills, point occupancy, flag runs, bomb plants/defuses.
+// ---------------------------------------------------------------------------
+struct BotProfile {
+    float killsPerSec = 0.08f;        // per bot, while alive
+    float pointMovesPerSec = 0.10f;   // Domination: chance to change point
+    float flagGrabsPerSec = 0.05f;    // CTF: chance to grab an enemy flag at base
+    float flagRunSec = 12.0f;         // CTF: carry time before attempting capture
+    float flagReturnSec = 30.0f;      // CTF: dropped flag auto-return
+    float plantAfterSec = 25.0f;      // SnD: round time before carrier plants
+    float defuseAfterSec = 20.0f;     // SnD: bomb time before a defender defuses
+    float defuseChance = 0.5f;        // SnD: chance a plant gets a defuse attempt
+    bool batchCombatEvents = true;    // events via IngestCombatEvents (tracks match stats) vs per-call APIs
+};
+
+struct BotMatchStats {
+    uint64_t ticks = 0;
+    uint64_t kills = 0;
+    uint64_t pointMoves = 0;
+    uint64_t flagPickups = 0;
+    uint64_t flagCaptures = 0;
+    uint64_t bombPlants = 0;
+    uint64_t bombDefuses = 0;
+    uint64_t matchesCompleted = 0;
+
+    uint64_t Events() const {
+        return kills + pointMoves + flagPickups + flagCaptures + bombPlants + bombDefuses;
+    }
+    void Accumulate(const BotMatchStats& other);
+};
+
+struct ScriptedBot {
+    PlayerId id = 0;
+    Team team = Team::None;
+    bool alive = true;
+    float respawnSec = 0.0f;
+    float actionSec = 0.0f;
+};
+
+class BotMatch {
+public:
+    BotMatch(GameMode mode, int botCount, PlayerId firstPlayerId, uint32_t seed,
+             BotProfile profile = BotProfile{});
+
+    void Tick(float deltaSec);
+
+    GameServer& Server() { return server_; }
+    const GameServer& Server() const { return server_; }
+    const BotMatchStats& Stats() const { return stats_; }
+    GameMode Mode() const { return mode_; }
+
+private:
+    void TickKills(float deltaSec);
+    void TickDomination(float deltaSec);
+    void TickCTF(float deltaSec);
+    void TickSND(float deltaSec);
+    void Emit(const CombatEvent& ev);
+    void Kill(ScriptedBot& killer, ScriptedBot& victim);
+    ScriptedBot* PickEnemy(Team team);
+    bool Chance(float perSec, float deltaSec);
+    bool IsMatchOver() const;
+    void RestartMatch();
+
+    GameMode mode_;
+    BotProfile profile_;
+    GameServer server_;
+    std::vector<ScriptedBot> bots_;
+    std::vector<CombatEvent> pendingKills_;
+    std::mt19937 rng_;
+    std::uniform_real_distribution<float> unit_{ 0.0f, 1.0f };
+    float flagReturnSec_[kMaxTeams] = { 0.0f, 0.0f };
+    float sndRoundSec_ = 0.0f;
+    bool sndDefuseAttempt_ = false;
+    BotMatchStats stats_;
+};
+
+// ---------------------------------------------------------------------------
+// Runs many BotMatches on the calling thread and measures throughput.
+// ---------------------------------------------------------------------------
+struct BotLoadResult {
+    int matches = 0;
+    uint64_t matchTicks = 0;     // sum of ticks across all matches
+    double wallSec = 0.0;
+    double cpuSec = 0.0;
+    BotMatchStats totals;
+
+    double TicksPerSec() const { return wallSec > 0.0 ? matchTicks / wallSec : 0.0; }
+    double CpuUsPerMatchTick() const { return matchTicks ? cpuSec * 1e6 / matchTicks : 0.0; }
+};
+
+BotLoadResult RunBotLoad(GameMode mode, int matches, int botsPerMatch, int ticks,
+                         float tickSec, uint32_t seed, const BotProfile& profile = BotProfile{});
+
+} // namespace game
@@ -0,0 +1,64 @@
+/**
+ * Virtual Sim — Headless bot load driver
+ * Runs scripted bots against 1, 100 and 1000 concurrent GameServer matches
+ * for TDM, Domination, CTF and Search and Destroy and reports throughput.
+ *
+ * Usage: bot_load [--bots N] [--ticks N] [--mode tdm|dom|ctf|snd] [--per-call 1]
+ */
+
+#include "BotDriver.h"
+#include "GameTypes.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace game;
+
+struct ModeEntry {
+    const char* name;
+    GameMode mode;
+};
+
+static const ModeEntry kModes[] = {
+    { "tdm", GameMode::TeamDeathmatch },
+    { "dom", GameMode::Domination },
+    { "ctf", GameMode::CaptureTheFlag },
+    { "snd", GameMode::SearchAndDestroy },
+};
+
+static const int kMatchCounts[] = { 1, 100, 1000 };
+
+int main(int argc, char** argv) {
+    int botsPerMatch = 10;
+    int matchTickBudget = 600000;  // total match-ticks per run; ticks = budget / matches
+    const char* onlyMode = nullptr;
+    BotProfile profile;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--bots") == 0) botsPerMatch = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--ticks") == 0) matchTickBudget = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--mode") == 0) onlyMode = argv[i + 1];
+        else if (std::strcmp(argv[i], "--per-call") == 0) profile.batchCombatEvents = std::atoi(argv[i + 1]) == 0;
+    }
+    if (botsPerMatch < 2) botsPerMatch = 2;
+
+    const float tickSec = 1.0f / 20.0f;
+
+    std::printf("%-4s %8s %8s %14s %16s %10s %10s %8s\n",
+                "mode", "matches", "ticks", "ticks/sec", "cpu us/match-tick", "events", "kills", "ended");
+    for (const auto& entry : kModes) {
+        if (onlyMode && std::strcmp(onlyMode, entry.name) != 0) continue;
+        for (int matches : kMatchCounts) {
+            int ticks = matchTickBudget / matches;
+            if (ticks < 200) ticks = 200;
+            BotLoadResult r = RunBotLoad(entry.mode, matches, botsPerMatch, ticks, tickSec, 1234u, profile);
+            std::printf("%-4s %8d %8d %14.0f %16.3f %10llu %10llu %8llu\n",
+                        entry.name, matches, ticks, r.TicksPerSec(), r.CpuUsPerMatchTick(),
+                        static_cast<unsigned long long>(r.totals.Events()),
+                        static_cast<unsigned long long>(r.totals.kills),
+                        static_cast<unsigned long long>(r.totals.matchesCompleted));
+        }
+    }
+    return 0;
+}
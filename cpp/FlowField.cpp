@@ -0,0 +1,198 @@
+#include "FlowField.h"
+#include <algorithm>
+
+namespace game {
+
+namespace {
+
+constexpr float kInvSqrt2 = 0.70710678f;
+
+// Neighbour steps (dCol, dRow): 4 orthogonal, then 4 diagonal, ordered so
+// that step k ^ 1 is the opposite of step k. Index 8 = no direction.
+constexpr int32_t kDCol[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+constexpr int32_t kDRow[8] = { 0, 0, 1, -1, 1, -1, -1, 1 };
+constexpr uint32_t kStepCost[8] = { 10, 10, 10, 10, 14, 14, 14, 14 };  // cell size = 10
+constexpr float kDirX[9] = { 1.0f, -1.0f, 0.0f, 0.0f, kInvSqrt2, -kInvSqrt2, kInvSqrt2, -kInvSqrt2, 0.0f };
+constexpr float kDirZ[9] = { 0.0f, 0.0f, 1.0f, -1.0f, kInvSqrt2, -kInvSqrt2, -kInvSqrt2, kInvSqrt2, 0.0f };
+
+} // namespace
+
+// ---- NavGrid ----
+
+NavGrid::NavGrid(int32_t cols, int32_t rows, float cellSize, float originX, float originZ)
+    : cols_(cols), rows_(rows), cellSize_(cellSize), invCellSize_(1.0f / cellSize),
+      originX_(originX), originZ_(originZ),
+      cells_(static_cast<size_t>(cols) * static_cast<size_t>(rows), 0) {}
+
+void NavGrid::SetBlocked(int32_t col, int32_t row, bool blocked) {
+    if (col < 0 || col >= cols_ || row < 0 || row >= rows_) return;
+    cells_[static_cast<size_t>(row) * static_cast<size_t>(cols_) + static_cast<size_t>(col)] = blocked ? 1 : 0;
+}
+
+int32_t NavGrid::CellAt(float x, float z) const {
+    float fx = (x - originX_) * invCellSize_;
+    float fz = (z - originZ_) * invCellSize_;
+    // Truncation equals floor for everything >= 0; negatives are outside anyway.
+    if (!(fx >= 0.0f) || !(fz >= 0.0f)) return -1;
+    int32_t col = static_cast<int32_t>(fx);
+    int32_t row = static_cast<int32_t>(fz);
+    if (col >= cols_ || row >= rows_) return -1;
+    return row * cols_ + col;
+}
+
+Vec3 NavGrid::CellCenter(int32_t cell) const {
+    int32_t row = cell / cols_;
+    int32_t col = cell % cols_;
+    return Vec3{ originX_ + (static_cast<float>(col) + 0.5f) * cellSize_, 0.0f,
+                 originZ_ + (static_cast<float>(row) + 0.5f) * cellSize_ };
+}
+
+// ---- FlowField ----
+
+void FlowField::Build(const NavGrid& grid, int32_t goalCell) {
+    const size_t n = grid.CellCount();
+    const int32_t cols = grid.Cols();
+    const int32_t rows = grid.Rows();
+    goalCell_ = goalCell;
+    dist_.assign(n, kUnreachableCost);
+    dir_.assign(n, kNoDirection);
+    if (goalCell < 0 || static_cast<size_t>(goalCell) >= n) return;
+
+    // Dijkstra outward from the goal with Dial's bucket queue: step costs are
+    // 10 and 14, so a ring of 15 buckets indexed by distance holds everything
+    // still pending and each cell is settled in O(1).
+    for (auto& b : buckets_) b.clear();
+    dist_[static_cast<size_t>(goalCell)] = 0;
+    buckets_[0].push_back(goalCell);
+    size_t pending = 1;
+    for (uint32_t cur = 0; pending > 0; ++cur) {
+        std::vector<int32_t>& bucket = buckets_[cur % kBucketRing];
+        pending -= bucket.size();
+        for (int32_t cell : bucket) {
+            if (dist_[static_cast<size_t>(cell)] != cur) continue;  // settled earlier at a lower cost
+            int32_t row = cell / cols;
+            int32_t col = cell % cols;
+            for (int k = 0; k < 8; ++k) {
+                int32_t nc = col + kDCol[k];
+                int32_t nr = row + kDRow[k];
+                if (nc < 0 || nc >= cols || nr < 0 || nr >= rows) continue;
+                int32_t next = nr * cols + nc;
+                if (!grid.Walkable(next)) continue;
+                // No corner cutting: both orthogonal cells beside a diagonal step must be open.
+                if (k >= 4 && (!grid.Walkable(row * cols + nc) || !grid.Walkable(nr * cols + col))) continue;
+                uint32_t nd = cur + kStepCost[k];
+                if (nd < dist_[static_cast<size_t>(next)]) {
+                    dist_[static_cast<size_t>(next)] = nd;
+                    // Steps are symmetric, so from next the goal lies back along k ^ 1.
+                    dir_[static_cast<size_t>(next)] = static_cast<uint8_t>(k ^ 1);
+                    buckets_[nd % kBucketRing].push_back(next);
+                    ++pending;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+Vec3 FlowField::Direction(int32_t cell) const {
+    if (cell < 0 || static_cast<size_t>(cell) >= dir_.size()) return Vec3{};
+    uint8_t k = dir_[static_cast<size_t>(cell)];
+    return Vec3{ kDirX[k], 0.0f, kDirZ[k] };
+}
+
+// ---- FlowFieldSet ----
+
+void FlowFieldSet::SetGrid(NavGrid grid) {
+    grid_ = std::move(grid);
+    for (auto& t : targets_) {
+        t.cell = grid_.CellAt(t.position.x, t.position.z);
+        t.field = FlowField{};
+        t.staleSince = updates_ + 1;
+    }
+}
+
+void FlowFieldSet::SetTarget(uint32_t targetId, const Vec3& position) {
+    int32_t cell = grid_.CellAt(position.x, position.z);
+    auto it = std::find_if(targets_.begin(), targets_.end(), [&](const Target& t) { return t.id == targetId; });
+    if (it == targets_.end()) {
+        targets_.push_back(Target{});
+        it = targets_.end() - 1;
+        it->id = targetId;
+        it->staleSince = updates_ + 1;
+    } else if (cell != it->cell && it->staleSince == 0) {
+        it->staleSince = updates_ + 1;
+    }
+    it->cell = cell;
+    it->position = position;
+}
+
+void FlowFieldSet::RemoveTarget(uint32_t targetId) {
+    targets_.erase(std::remove_if(targets_.begin(), targets_.end(), [&](const Target& t) { return t.id == targetId; }),
+                   targets_.end());
+}
+
+void FlowFieldSet::ClearTargets() {
+    targets_.clear();
+}
+
+int FlowFieldSet::Update() {
+    ++updates_;
+    int rebuilt = 0;
+    while (rebuilt < config_.maxRebuildsPerUpdate) {
+        Target* oldest = nullptr;
+        for (auto& t : targets_)
+            if (t.staleSince != 0 && t.cell >= 0 && (!oldest || t.staleSince < oldest->staleSince))
+                oldest = &t;
+        if (!oldest) break;
+        if (oldest->cell != oldest->field.GoalCell())
+            oldest->field.Build(grid_, oldest->cell);
+        oldest->staleSince = 0;
+        ++rebuilt;
+        ++rebuilds_;
+    }
+    return rebuilt;
+}
+
+int32_t FlowFieldSet::NearestField(int32_t cell) const {
+    if (cell < 0) return -1;
+    int32_t best = -1;
+    uint32_t bestDist = FlowField::kUnreachableCost;
+    for (size_t i = 0; i < targets_.size(); ++i) {
+        const FlowField& f = targets_[i].field;
+        if (f.GoalCell() < 0) continue;
+        uint32_t d = f.Cost(cell);
+        if (d < bestDist) {
+            bestDist = d;
+            best = static_cast<int32_t>(i);
+        }
+    }
+    return best;
+}
+
+Vec3 FlowFieldSet::SampleNearest(const Vec3& position) const {
+    int32_t cell = grid_.CellAt(position.x, position.z);
+    int32_t f = NearestField(cell);
+    return f < 0 ? Vec3{} : targets_[static_cast<size_t>(f)].field.Direction(cell);
+}
+
+void FlowFieldSet::SampleNearest(Span<const float> xs, Span<const float> zs,
+                                 Span<float> dirX, Span<float> dirZ, Span<float> dist) const {
+    const float costToWorld = grid_.CellSize() * 0.1f;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        int32_t cell = grid_.CellAt(xs[i], zs[i]);
+        int32_t f = NearestField(cell);
+        if (f < 0) {
+            dirX[i] = 0.0f;
+            dirZ[i] = 0.0f;
+            dist[i] = kNoPathDistance;
+            continue;
+        }
+        const FlowField& field = targets_[static_cast<size_t>(f)].field;
+        Vec3 d = field.Direction(cell);
+        dirX[i] = d.x;
+        dirZ[i] = d.z;
+        dist[i] = static_cast<float>(field.Cost(cell)) * costToWorld;
+    }
+}
+
+} // namespace game
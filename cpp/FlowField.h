@@ -0,0 +1,127 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "Span.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Walkable grid over the x/z plane, same cell convention as aStarGrid in
+// game-ai-pathfinder.js: 0 = walkable, 1 = obstacle, row-major, cell (0, 0)
+// starting at origin.
+// ---------------------------------------------------------------------------
+class NavGrid {
+public:
+    NavGrid() = default;
+    NavGrid(int32_t cols, int32_t rows, float cellSize, float originX = 0.0f, float originZ = 0.0f);
+
+    int32_t Cols() const { return cols_; }
+    int32_t Rows() const { return rows_; }
+    float CellSize() const { return cellSize_; }
+    size_t CellCount() const { return cells_.size(); }
+
+    void SetBlocked(int32_t col, int32_t row, bool blocked);
+    bool Walkable(int32_t cell) const { return cells_[static_cast<size_t>(cell)] == 0; }
+
+    // Cell index containing (x, z), or -1 outside the grid.
+    int32_t CellAt(float x, float z) const;
+    Vec3 CellCenter(int32_t cell) const;
+
+private:
+    int32_t cols_ = 0;
+    int32_t rows_ = 0;
+    float cellSize_ = 1.0f;
+    float invCellSize_ = 1.0f;
+    float originX_ = 0.0f;
+    float originZ_ = 0.0f;
+    std::vector<uint8_t> cells_;
+};
+
+// ---------------------------------------------------------------------------
+// Dijkstra flow field toward one goal cell: 8-connected, diagonal cost 1.4
+// cells, no corner cutting past obstacles. Each cell stores its distance to
+// the goal and the direction of its next step, so following the field is one
+// lookup per agent.
+// ---------------------------------------------------------------------------
+class FlowField {
+public:
+    static constexpr uint8_t kNoDirection = 8;
+
+    void Build(const NavGrid& grid, int32_t goalCell);
+
+    int32_t GoalCell() const { return goalCell_; }
+    bool Reachable(int32_t cell) const { return cell >= 0 && dist_[static_cast<size_t>(cell)] != kUnreachableCost; }
+    // Path length in tenths of a cell (kUnreachableCost when unreachable).
+    uint32_t Cost(int32_t cell) const { return dist_[static_cast<size_t>(cell)]; }
+    // Unit x/z direction toward the goal (zero at the goal or when unreachable).
+    Vec3 Direction(int32_t cell) const;
+
+    static constexpr uint32_t kUnreachableCost = 0xFFFFFFFFu;
+
+private:
+    static constexpr size_t kBucketRing = 15;  // > largest step cost
+
+    int32_t goalCell_ = -1;
+    std::vector<uint32_t> dist_;
+    std::vector<uint8_t> dir_;
+    std::vector<int32_t> buckets_[kBucketRing];  // Build scratch
+};
+
+struct FlowFieldConfig {
+    int maxRebuildsPerUpdate = 2;  // fields rebuilt per Update; the rest wait
+};
+
+// ---------------------------------------------------------------------------
+// One FlowField per target (player). A field is rebuilt only when its target
+// moves to another cell, at most maxRebuildsPerUpdate per Update, longest-
+// waiting first; until then agents follow the previous field, which still
+// leads to the target's old cell next to the new one.
+// ---------------------------------------------------------------------------
+class FlowFieldSet {
+public:
+    explicit FlowFieldSet(FlowFieldConfig config = FlowFieldConfig{}) : config_(config) {}
+
+    void SetGrid(NavGrid grid);
+    const NavGrid& Grid() const { return grid_; }
+
+    void SetTarget(uint32_t targetId, const Vec3& position);
+    void RemoveTarget(uint32_t targetId);
+    void ClearTargets();
+    size_t TargetCount() const { return targets_.size(); }
+
+    // Rebuilds up to maxRebuildsPerUpdate stale fields; returns how many.
+    int Update();
+
+    // Direction toward the nearest target by path distance (zero if none is
+    // reachable). The batch form writes one x/z direction and the path
+    // distance in world units (kNoPathDistance if unreachable) per position.
+    Vec3 SampleNearest(const Vec3& position) const;
+    void SampleNearest(Span<const float> xs, Span<const float> zs,
+                       Span<float> dirX, Span<float> dirZ, Span<float> dist) const;
+
+    static constexpr float kNoPathDistance = 1.0e30f;
+
+    uint64_t RebuildCount() const { return rebuilds_; }
+
+private:
+    struct Target {
+        uint32_t id = 0;
+        int32_t cell = -1;       // where the target is now
+        Vec3 position;           // cell is recomputed from this when the grid changes
+        uint64_t staleSince = 0; // update counter when cell last changed; 0 = fresh
+        FlowField field;         // built toward field.GoalCell()
+    };
+
+    int32_t NearestField(int32_t cell) const;
+
+    FlowFieldConfig config_;
+    NavGrid grid_;
+    std::vector<Target> targets_;
+    uint64_t updates_ = 0;
+    uint64_t rebuilds_ = 0;
+};
+
+} // namespace game
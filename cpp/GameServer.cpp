@@ -1,11 +1,15 @@
 #include "GameServer.h"
+#include <algorithm>
 
 namespace game {
 
 void GameServer::SetGameMode(GameMode mode) {
     if (currentMode_ == mode) return;
+    EndMatch();
     ResetMultiplayerState();
     currentMode_ = mode;
+    stats_.BeginMatch(mode);
+    matchSummaryEmitted_ = false;
 
     switch (mode) {
     case GameMode::TeamDeathmatch:
@@ -43,8 +47,30 @@ void GameServer::SetGameMode(GameMode mode) {
     }
 }
 
+void GameServer::AttachQuestStore(QuestProgressStore* store) {
+    questStore_ = store;
+    if (store)
+        quests_.SetPersistCallback([store](const QuestLogRecord& record) { store->Append(record); });
+    else
+        quests_.SetPersistCallback(nullptr);
+}
+
+void GameServer::AttachAnalytics(ProgressionAnalytics* analytics) {
+    quests_.SetAnalytics(analytics, 0);
+    missions_.SetAnalytics(analytics, 0);
+}
+
+void GameServer::StageQuestPack(std::shared_ptr<const QuestPack> pack) {
+    std::lock_guard<std::mutex> lock(stagedPackMutex_);
+    stagedPack_ = std::move(pack);
+    packStaged_.store(true, std::memory_order_release);
+}
+
 void GameServer::AddPlayer(PlayerId playerId, Team team) {
+    if (questStore_ && players_.find(playerId) == players_.end() && questStore_->LoadPlayer(playerId, questLoad_))
+        quests_.RestorePlayer(playerId, questLoad_);
     players_[playerId] = team;
+    stats_.AddPlayer(playerId, team);
 
     if (currentMode_ == GameMode::TeamDeathmatch && team != Team::None && team != Team::Spectator)
         tdm_.AddPlayer(playerId, team);
@@ -60,6 +86,8 @@ void GameServer::AddPlayer(PlayerId playerId, Team team) {
 
 void GameServer::RemovePlayer(PlayerId playerId) {
     players_.erase(playerId);
+    if (questStore_) quests_.RemovePlayer(playerId);  // progress is in the store
+    stats_.RemovePlayer(playerId);
     tdm_.RemovePlayer(playerId);
     dom_.RemovePlayer(playerId);
     ctf_.RemovePlayer(playerId);
@@ -71,6 +99,7 @@ void GameServer::SetPlayerTeam(PlayerId playerId, Team team) {
     auto it = players_.find(playerId);
     if (it == players_.end()) return;
     it->second = team;
+    stats_.SetPlayerTeam(playerId, team);
 
     if (currentMode_ == GameMode::TeamDeathmatch) {
         tdm_.RemovePlayer(playerId);
@@ -91,8 +120,162 @@ void GameServer::SetPlayerTeam(PlayerId playerId, Team team) {
     }
 }
 
+void GameServer::BalanceTeams(Span<const BalanceMember> members) {
+    balancer_.Solve(members, split_);
+    for (size_t i = 0; i < members.size(); ++i)
+        SetPlayerTeam(members[i].playerId, split_.teams[i]);
+}
+
+void GameServer::DispatchCombatEventsToMode(Span<const CombatEvent> events) {
+    for (const auto& ev : events) {
+        switch (ev.type) {
+        case CombatEventType::Kill:
+            if (currentMode_ == GameMode::TeamDeathmatch)
+                tdm_.OnKill(ev.killerId, ev.victimId);
+            else if (currentMode_ == GameMode::SearchAndDestroy)
+                snd_.OnPlayerKilled(ev.victimId);
+            stats_.RecordKill(ev.killerId, ev.victimId);
+            break;
+        case CombatEventType::ZombieKill: {
+            if (currentMode_ != GameMode::Zombies) break;
+            int before = zombies_.GetRoundState().zombiesKilledThisRound;
+            zombies_.OnZombieKilled(ev.victimId, ev.killerId);
+            if (zombies_.GetRoundState().zombiesKilledThisRound != before)
+                stats_.RecordZombieKill(ev.killerId);
+            break;
+        }
+        case CombatEventType::FlagCapture: {
+            if (currentMode_ != GameMode::CaptureTheFlag) break;
+            auto team = players_.find(ev.killerId);
+            if (team == players_.end()) break;
+            auto score = ctf_.GetState().teamScores.find(team->second);
+            int32_t before = score != ctf_.GetState().teamScores.end() ? score->second : 0;
+            ctf_.CaptureFlag(ev.killerId);
+            score = ctf_.GetState().teamScores.find(team->second);
+            if (score != ctf_.GetState().teamScores.end() && score->second != before)
+                stats_.RecordFlagCapture(ev.killerId);
+            break;
+        }
+        case CombatEventType::BombPlant:
+            if (currentMode_ != GameMode::SearchAndDestroy) break;
+            snd_.OnBombPlanted(ev.killerId);
+            if (snd_.GetState().bombState == BombState::Planted)
+                stats_.RecordBombPlant(ev.killerId);
+            break;
+        case CombatEventType::BombDefuse:
+            if (currentMode_ != GameMode::SearchAndDestroy || snd_.GetState().bombState != BombState::Planted) break;
+            snd_.OnBombDefused(ev.killerId);
+            stats_.RecordBombDefuse(ev.killerId);
+            break;
+        }
+    }
+}
+
+void GameServer::IngestCombatEvents(Span<const CombatEvent> events) {
+    if (events.empty()) return;
+
+    DispatchCombatEventsToMode(events);
+    NotifyKillProgress(events);
+}
+
+void GameServer::ApplyZombieDamage(Span<const ZombieHit> hits) {
+    if (currentMode_ != GameMode::Zombies || hits.empty()) return;
+
+    zombieKills_.clear();
+    if (zombies_.ApplyDamageBatch(hits, &zombieKills_) == 0) return;
+
+    zombieKillEvents_.clear();
+    for (const ZombieKillRecord& kill : zombieKills_) {
+        stats_.RecordZombieKill(kill.killerId);
+        zombieKillEvents_.push_back({ CombatEventType::ZombieKill, kill.killerId, kill.zombieId, sym::kZombie });
+    }
+    NotifyKillProgress(zombieKillEvents_);
+}
+
+void GameServer::DrainZombieDamage() {
+    drainedHits_.clear();
+    if (zombieDamageQueue_.Drain(drainedHits_) == 0) return;
+    CoalesceZombieHits(drainedHits_, coalesceKeys_, coalescedHits_);
+    ApplyZombieDamage(coalescedHits_);
+}
+
+void GameServer::NotifyKillProgress(Span<const CombatEvent> events) {
+    // Quest and mission progress is per player, so grouping by killer (stable,
+    // keeping each player's event order) gives the same results as the
+    // per-call path with one progress lookup per player instead of per event.
+    batchOrder_.clear();
+    for (size_t i = 0; i < events.size(); ++i)
+        if (events[i].type == CombatEventType::Kill || events[i].type == CombatEventType::ZombieKill)
+            batchOrder_.push_back(static_cast<uint32_t>(i));
+    std::stable_sort(batchOrder_.begin(), batchOrder_.end(), [&](uint32_t a, uint32_t b) {
+        return events[a].killerId < events[b].killerId;
+    });
+
+    size_t runStart = 0;
+    while (runStart < batchOrder_.size()) {
+        PlayerId killer = events[batchOrder_[runStart]].killerId;
+        batchTags_.clear();
+        size_t runEnd = runStart;
+        while (runEnd < batchOrder_.size() && events[batchOrder_[runEnd]].killerId == killer) {
+            batchTags_.push_back(events[batchOrder_[runEnd]].targetTag);
+            ++runEnd;
+        }
+        quests_.NotifyKills(killer, batchTags_);
+        missions_.NotifyKills(killer, batchTags_);
+        runStart = runEnd;
+    }
+}
+
+bool GameServer::IsMatchOver() const {
+    switch (currentMode_) {
+    case GameMode::TeamDeathmatch:   return tdm_.IsGameOver();
+    case GameMode::Domination:       return dom_.IsGameOver();
+    case GameMode::CaptureTheFlag:   return ctf_.IsGameOver();
+    case GameMode::SearchAndDestroy: return snd_.IsMatchOver();
+    default:                         return false;
+    }
+}
+
+Team GameServer::MatchWinner() const {
+    switch (currentMode_) {
+    case GameMode::TeamDeathmatch: return tdm_.GetState().winningTeam;
+    case GameMode::Domination:     return dom_.GetState().winningTeam;
+    case GameMode::CaptureTheFlag: return ctf_.GetState().winningTeam;
+    case GameMode::SearchAndDestroy: {
+        int alpha = snd_.GetState().roundsWon.at(Team::Alpha);
+        int bravo = snd_.GetState().roundsWon.at(Team::Bravo);
+        return alpha == bravo ? Team::None : (alpha > bravo ? Team::Alpha : Team::Bravo);
+    }
+    default:
+        return Team::None;
+    }
+}
+
+void GameServer::EndMatch() {
+    if (currentMode_ == GameMode::None || matchSummaryEmitted_) return;
+    matchSummaryEmitted_ = true;
+    if (onMatchSummary_)
+        onMatchSummary_(stats_.BuildSummary(MatchWinner()));
+}
+
+bool GameServer::ApplyStagedQuestPack() {
+    if (!packStaged_.load(std::memory_order_acquire)) return false;
+    std::shared_ptr<const QuestPack> pack;
+    {
+        std::lock_guard<std::mutex> lock(stagedPackMutex_);
+        pack = std::move(stagedPack_);
+        packStaged_.store(false, std::memory_order_relaxed);
+    }
+    quests_.UsePack(std::move(pack));
+    return true;
+}
+
 void GameServer::Tick(float deltaSec) {
+    ApplyStagedQuestPack();
+    DrainZombieDamage();
     missions_.Tick(deltaSec);
+    if (currentMode_ != GameMode::None)
+        stats_.AdvanceTime(deltaSec);
 
     switch (currentMode_) {
     case GameMode::Domination:
@@ -107,6 +290,9 @@ void GameServer::Tick(float deltaSec) {
     default:
         break;
     }
+
+    if (!matchSummaryEmitted_ && IsMatchOver())
+        EndMatch();
 }
 
 void GameServer::ResetMultiplayerState() {
@@ -2,27 +2,59 @@
 
 #include "GameTypes.h"
 #include "Quest.h"
+#include "QuestStore.h"
 #include "Mission.h"
 #include "MultiplayerModes.h"
 #include "Zombies.h"
+#include "ZombieDamageQueue.h"
+#include "MatchStats.h"
+#include "TeamBalance.h"
+#include "Span.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace game {
 
+class ProgressionAnalytics;
+
 class GameServer {
 public:
+    using MatchSummaryCallback = std::function<void(const MatchSummaryRecord&)>;
+
     GameServer() = default;
 
     // ---- Quests ----
     QuestSystem& Quests() { return quests_; }
     const QuestSystem& Quests() const { return quests_; }
+    // Optional durable quest progress: every mutation is appended to the
+    // store, AddPlayer loads a joining player's progress from it and
+    // RemovePlayer drops it from memory. The store must stay open while
+    // attached; nullptr detaches.
+    void AttachQuestStore(QuestProgressStore* store);
+    // Hot reload: hands a compiled quest pack (QuestPack::Open, any thread)
+    // to the next Tick, which switches to it before running anything else.
+    // A later call before that Tick replaces the staged pack.
+    void StageQuestPack(std::shared_ptr<const QuestPack> pack);
+    // Switches to the staged pack now (what Tick does first); for hosts
+    // without a tick loop, from the thread that owns the server. False if
+    // nothing was staged.
+    bool ApplyStagedQuestPack();
 
     // ---- Missions ----
     MissionSystem& Missions() { return missions_; }
     const MissionSystem& Missions() const { return missions_; }
 
+    // ---- Progression analytics ----
+    // Quest and mission events are recorded from the sim thread as producer
+    // 0. The stream must stay open while attached; nullptr detaches.
+    void AttachAnalytics(ProgressionAnalytics* analytics);
+
     // ---- Multiplayer ----
     void SetGameMode(GameMode mode);
     GameMode GetGameMode() const { return currentMode_; }
@@ -42,19 +74,56 @@ public:
     ZombiesMode& Zombies() { return zombies_; }
     const ZombiesMode& Zombies() const { return zombies_; }
 
+    // ---- Match statistics (ReadSnapshot is safe from any thread) ----
+    MatchStats& Stats() { return stats_; }
+    const MatchStats& Stats() const { return stats_; }
+    void SetMatchSummaryCallback(MatchSummaryCallback cb) { onMatchSummary_ = std::move(cb); }
+    // Emits the summary for the current match if it has not been emitted yet
+    // (modes without a natural end, or matches cut short).
+    void EndMatch();
+
     void AddPlayer(PlayerId playerId, Team team = Team::None);
     void RemovePlayer(PlayerId playerId);
     void SetPlayerTeam(PlayerId playerId, Team team);
+    // Splits the given players into skill-balanced Alpha/Bravo teams (parties
+    // kept together) and applies the result through SetPlayerTeam.
+    void BalanceTeams(Span<const BalanceMember> members);
+
+    // Per-tick batch of combat events: fans out to the active mode, match
+    // stats, quests and missions. Results match issuing each event through
+    // those APIs in order.
+    void IngestCombatEvents(Span<const CombatEvent> events);
+
+    // Per-tick batch of zombie hits (Zombies mode only). Kills go through
+    // ZombiesMode::ApplyDamageBatch, then to match stats, quests and missions
+    // as "zombie" kills.
+    void ApplyZombieDamage(Span<const ZombieHit> hits);
+
+    // Hits from network threads: each thread pushes into its own ring
+    // (ZombieDamage().Init sizes them before the threads start). Tick drains
+    // every ring first, coalesces same-zombie hits and applies them through
+    // ApplyZombieDamage; outside Zombies mode drained hits are discarded.
+    ZombieDamageQueue& ZombieDamage() { return zombieDamageQueue_; }
 
     void Tick(float deltaSec);
 
 private:
     void ResetMultiplayerState();
+    void DispatchCombatEventsToMode(Span<const CombatEvent> events);
+    void NotifyKillProgress(Span<const CombatEvent> events);
+    void DrainZombieDamage();
+    bool IsMatchOver() const;
+    Team MatchWinner() const;
 
     GameMode currentMode_ = GameMode::None;
     std::unordered_map<PlayerId, Team> players_;
 
     QuestSystem quests_;
+    QuestProgressStore* questStore_ = nullptr;
+    std::vector<QuestLogRecord> questLoad_;  // AddPlayer scratch
+    std::mutex stagedPackMutex_;
+    std::shared_ptr<const QuestPack> stagedPack_;
+    std::atomic<bool> packStaged_{ false };  // lets Tick skip the lock
     MissionSystem missions_;
 
     TeamDeathmatch tdm_;
@@ -62,6 +131,25 @@ private:
     CaptureTheFlag ctf_;
     SearchAndDestroy snd_;
     ZombiesMode zombies_;
+
+    MatchStats stats_;
+    MatchSummaryCallback onMatchSummary_;
+    bool matchSummaryEmitted_ = false;
+
+    TeamBalancer balancer_;
+    TeamSplit split_;
+
+    // Scratch for IngestCombatEvents; reused across ticks.
+    std::vector<uint32_t> batchOrder_;
+    std::vector<SymbolId> batchTags_;
+    std::vector<ZombieKillRecord> zombieKills_;
+    std::vector<CombatEvent> zombieKillEvents_;
+
+    ZombieDamageQueue zombieDamageQueue_;
+    // DrainZombieDamage scratch.
+    std::vector<ZombieHit> drainedHits_;
+    std::vector<uint64_t> coalesceKeys_;
+    std::vector<ZombieHit> coalescedHits_;
 };
 
 } // namespace game
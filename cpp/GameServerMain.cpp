@@ -59,6 +59,7 @@ public:
     
     void SetGameServer(GameServer* gs) { gameServer_ = gs; }
     void SetContentPath(const std::string& path) { contentPath_ = path; }
+    void SetQuestPackPath(const std::string& path) { questPackPath_ = path; }
 
 private:
     void RunServer() {
@@ -140,7 +141,7 @@ private:
         std::string response;
         
         if (path.find("api/") == 0) {
-            response = HandleAPI(path);
+            response = HandleAPI(method, path);
         } else {
             response = ServeFile(path);
         }
@@ -180,13 +181,93 @@ private:
         return response.str();
     }
     
-    std::string HandleAPI(const std::string& path) {
+    std::string HandleAPI(const std::string& method, const std::string& path) {
         if (!gameServer_) return "HTTP/1.1 500 Internal Server Error\r\n\r\n";
         
         if (path == "api/quests") {
             return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n{\"status\":\"ok\"}";
         }
-        
+
+        if (path == "api/quests/reload") {
+            // Hot reload after quest_packc rewrites quests.qpack. Players keep
+            // their progress (QuestSystem::UsePack). This executable runs no
+            // tick loop and only this thread touches the server, so the
+            // staged pack is applied here rather than by the next Tick.
+            if (method != "POST") return "HTTP/1.1 405 Method Not Allowed\r\nAllow: POST\r\n\r\n";
+            auto pack = QuestPack::Open(questPackPath_);
+            if (!pack) {
+                return "HTTP/1.1 422 Unprocessable Entity\r\nContent-Type: application/json\r\n\r\n"
+                       "{\"status\":\"error\",\"error\":\"missing or invalid quest pack\"}";
+            }
+            const uint32_t questCount = pack->QuestCount();
+            gameServer_->StageQuestPack(std::move(pack));
+            gameServer_->ApplyStagedQuestPack();
+            return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n{\"status\":\"ok\",\"quests\":" +
+                   std::to_string(questCount) + "}";
+        }
+
+        if (path == "api/match-stats") {
+            MatchStatsSnapshot snap;
+            gameServer_->Stats().ReadSnapshot(snap);
+            std::ostringstream body;
+            body << "{\"match\":" << snap.matchSeq
+                 << ",\"mode\":" << static_cast<int>(snap.mode)
+                 << ",\"elapsedSec\":" << snap.elapsedSec
+                 << ",\"players\":[";
+            for (int i = 0; i < snap.playerCount; ++i) {
+                const PlayerMatchStats& p = snap.players[static_cast<size_t>(i)];
+                body << (i ? "," : "")
+                     << "{\"id\":" << p.playerId
+                     << ",\"team\":" << static_cast<int>(p.team)
+                     << ",\"kills\":" << p.kills
+                     << ",\"deaths\":" << p.deaths
+                     << ",\"streak\":" << p.streak
+                     << ",\"bestStreak\":" << p.bestStreak
+                     << ",\"captures\":" << p.captures
+                     << ",\"plants\":" << p.plants
+                     << ",\"defuses\":" << p.defuses
+                     << ",\"zombieKills\":" << p.zombieKills << "}";
+            }
+            body << "]}";
+            return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n" + body.str();
+        }
+
+        if (path == "api/zombies") {
+            // Reads the mode through its visitors: no per-request copy of the
+            // zombie or player tables. (This executable runs no sim thread;
+            // a ticking server would need a snapshot like match-stats.)
+            const ZombiesMode& zm = gameServer_->Zombies();
+            const ZombiesRoundState& round = zm.GetRoundState();
+            std::ostringstream body;
+            body << "{\"round\":" << round.currentRound
+                 << ",\"remaining\":" << round.zombiesRemaining
+                 << ",\"queued\":" << round.zombiesQueued
+                 << ",\"players\":[";
+            bool first = true;
+            zm.ForEachPlayer([&](const ZombiesPlayerState& p) {
+                body << (first ? "" : ",")
+                     << "{\"id\":" << p.playerId
+                     << ",\"points\":" << p.points
+                     << ",\"lives\":" << p.lives
+                     << ",\"alive\":" << (p.alive ? "true" : "false")
+                     << ",\"downed\":" << (p.downed ? "true" : "false") << "}";
+                first = false;
+            });
+            body << "],\"zombies\":[";
+            first = true;
+            zm.ForEachZombie([&](const ZombieRef& z) {
+                Vec3 pos = z.Position();
+                body << (first ? "" : ",")
+                     << "{\"id\":" << z.Id()
+                     << ",\"type\":" << static_cast<int>(z.Type())
+                     << ",\"health\":" << z.Health()
+                     << ",\"x\":" << pos.x << ",\"y\":" << pos.y << ",\"z\":" << pos.z << "}";
+                first = false;
+            });
+            body << "]}";
+            return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n" + body.str();
+        }
+
         return "HTTP/1.1 404 Not Found\r\n\r\n";
     }
     
@@ -195,6 +276,7 @@ private:
     std::thread serverThread_;
     GameServer* gameServer_ = nullptr;
     std::string contentPath_ = ".";
+    std::string questPackPath_ = "quests.qpack";
 };
 
 void OpenBrowser(const std::string& url) {
@@ -212,12 +294,12 @@ int main(int argc, char** argv) {
     const std::string URL = "http://localhost:" + std::to_string(PORT);
     
     GameServer gameServer;
-    RegisterAllQuests(gameServer.Quests());
     
     SimpleHTTPServer httpServer(PORT);
     httpServer.SetGameServer(&gameServer);
     
     char exePath[1024] = {0};
+    std::string contentDir = ".";
 #ifdef _WIN32
     GetModuleFileNameA(nullptr, exePath, sizeof(exePath));
     std::string exeDir(exePath);
@@ -226,6 +308,7 @@ int main(int argc, char** argv) {
         exeDir = exeDir.substr(0, lastSlash);
     }
     httpServer.SetContentPath(exeDir);
+    contentDir = exeDir;
 #else
     if (readlink("/proc/self/exe", exePath, sizeof(exePath)) > 0) {
         std::string exeDir(exePath);
@@ -234,8 +317,19 @@ int main(int argc, char** argv) {
             exeDir = exeDir.substr(0, lastSlash);
         }
         httpServer.SetContentPath(exeDir);
+        contentDir = exeDir;
     }
 #endif
+
+    // Quest content: the compiled pack beside the executable (mapped, no
+    // parsing), else the built-in definitions. POST /api/quests/reload
+    // re-maps the pack after it is recompiled.
+    const std::string questPackPath = contentDir + "/quests.qpack";
+    httpServer.SetQuestPackPath(questPackPath);
+    if (auto pack = QuestPack::Open(questPackPath))
+        gameServer.Quests().UsePack(std::move(pack));
+    else
+        RegisterAllQuests(gameServer.Quests());
     
     httpServer.Start();
     
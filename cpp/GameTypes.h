@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Symbol.h"
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace game {
@@ -12,6 +16,15 @@ using QuestId = uint32_t;
 using MissionId = uint32_t;
 using ObjectiveId = uint32_t;
 
+struct Vec3 {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+// False if any component is NaN or infinite.
+inline bool IsFinite(const Vec3& v) { return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z); }
+
 // ---------------------------------------------------------------------------
 // Multiplayer
 // ---------------------------------------------------------------------------
@@ -39,6 +52,22 @@ inline constexpr int kSndRoundsToWin = 4;
 inline constexpr float kDominationTickIntervalSec = 1.0f;
 inline constexpr int kDominationPointsPerTick = 1;
 
+// Combat events ingested in per-tick batches by GameServer::IngestCombatEvents.
+enum class CombatEventType : uint8_t {
+    Kill,         // player killed player (victimId = player)
+    ZombieKill,   // player killed zombie (victimId = zombie id)
+    FlagCapture,  // CTF: killerId = capturing player
+    BombPlant,    // SnD: killerId = planter
+    BombDefuse    // SnD: killerId = defuser
+};
+
+struct CombatEvent {
+    CombatEventType type = CombatEventType::Kill;
+    PlayerId killerId = 0;
+    uint32_t victimId = 0;
+    SymbolId targetTag = kNoSymbol;  // quest/mission kill tag, e.g. sym::kEnemy, sym::kZombie
+};
+
 // ---------------------------------------------------------------------------
 // Quests
 // ---------------------------------------------------------------------------
@@ -67,6 +96,7 @@ struct QuestObjective {
     int32_t target = 0;
     std::string targetId;  // e.g. "zombie", "flag_capture"
     bool optional = false;
+    SymbolId targetSymbol = kNoSymbol;  // interned targetId (set by RegisterQuest)
 };
 
 enum class QuestCategory : uint8_t {
@@ -112,6 +142,7 @@ enum class MissionObjectiveType : uint8_t {
     Timed
 };
 
+// Template data; progress and completed are the values an instance starts with.
 struct MissionObjective {
     ObjectiveId id = 0;
     MissionObjectiveType type = MissionObjectiveType::EliminateAll;
@@ -120,8 +151,11 @@ struct MissionObjective {
     std::string targetTag;
     float timeLimitSec = 0.0f;
     bool completed = false;
+    SymbolId targetSymbol = kNoSymbol;  // interned targetTag (set by RegisterMission)
 };
 
+inline constexpr size_t kMaxMissionObjectives = 8;
+
 struct MissionDefinition {
     MissionId id = 0;
     std::string title;
@@ -130,13 +164,22 @@ struct MissionDefinition {
     MissionId nextMissionId = 0;
 };
 
+// A player's run of a mission: counters and flags only, indexed like the
+// definition's objectives (which hold everything immutable).
 struct MissionInstance {
     MissionId missionId = 0;
     MissionState state = MissionState::NotStarted;
+    uint8_t objectiveCount = 0;
+    uint8_t completedMask = 0;  // bit i = objective i complete
     int32_t currentObjectiveIndex = 0;
-    std::vector<MissionObjective> objectives;
     int64_t startedAt = 0;
+    std::array<int32_t, kMaxMissionObjectives> progress{};
+    std::array<float, kMaxMissionObjectives> timeLeftSec{};  // counts down only where the objective has a limit
+
+    bool Completed(size_t objective) const { return (completedMask >> objective) & 1u; }
+    void SetCompleted(size_t objective) { completedMask = static_cast<uint8_t>(completedMask | (1u << objective)); }
 };
+static_assert(kMaxMissionObjectives <= 8, "MissionInstance::completedMask is 8 bits");
 
 // ---------------------------------------------------------------------------
 // Search and Destroy
@@ -165,6 +208,7 @@ enum class ZombieType : uint8_t {
     Brute,
     Boss
 };
+inline constexpr int kZombieTypeCount = static_cast<int>(ZombieType::Boss) + 1;
 
 struct ZombieWaveConfig {
     int round = 1;
@@ -175,4 +219,11 @@ struct ZombieWaveConfig {
     float healthMultiplier = 1.0f;
 };
 
+// One hit in a ZombiesMode::ApplyDamageBatch call.
+struct ZombieHit {
+    uint32_t zombieId = 0;
+    PlayerId attackerId = 0;
+    float damage = 0.0f;
+};
+
 } // namespace game
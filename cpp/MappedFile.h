@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Read-only memory map of a whole file (mmap / MapViewOfFile). Move-only;
+// the mapping lives until Close or destruction.
+// ---------------------------------------------------------------------------
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file is missing, empty or cannot be mapped.
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Flushes stdio buffers and forces the file's data to stable storage
+// (fdatasync / _commit). False on any I/O error.
+bool SyncFile(std::FILE* file);
+
+// Forces a directory's entries (files created, renamed or removed in it) to
+// stable storage, so a new file survives a crash along with its contents.
+// A no-op returning true on Windows, where NTFS journals metadata.
+bool SyncDirectory(const std::string& path);
+
+} // namespace game
@@ -0,0 +1,215 @@
+#include "MatchStats.h"
+#include <algorithm>
+#include <limits>
+
+namespace game {
+
+static_assert(kMaxMatchSlots == 64, "free-slot mask is a single uint64_t");
+
+namespace {
+
+template <typename T>
+T Saturate(int32_t v) {
+    return static_cast<T>(std::clamp<int32_t>(v, 0, std::numeric_limits<T>::max()));
+}
+
+} // namespace
+
+MatchStats::MatchStats() {
+    for (int i = 0; i < kMaxMatchSlots; ++i) {
+        slotPlayer_[i].store(0, std::memory_order_relaxed);
+        slotTeam_[i].store(0, std::memory_order_relaxed);
+        ClearSlot(i);
+    }
+}
+
+void MatchStats::Bump(Counter& c, int slot, int32_t delta) {
+    // Single writer: a plain load/store pair is enough, no RMW needed.
+    c[slot].store(c[slot].load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+void MatchStats::Store(Counter& c, int slot, int32_t value) {
+    c[slot].store(value, std::memory_order_relaxed);
+}
+
+void MatchStats::BeginWrite() {
+    seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void MatchStats::EndWrite() {
+    seq_.store(seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void MatchStats::ClearSlot(int slot) {
+    for (Counter* c : { &kills_, &deaths_, &streak_, &bestStreak_, &captures_, &plants_, &defuses_, &zombieKills_ })
+        Store(*c, slot, 0);
+}
+
+int MatchStats::SlotOf(PlayerId playerId) const {
+    auto it = slotOf_.find(playerId);
+    return it != slotOf_.end() ? it->second : -1;
+}
+
+void MatchStats::BeginMatch(GameMode mode) {
+    BeginWrite();
+    matchSeq_.store(matchSeq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    mode_.store(static_cast<uint8_t>(mode), std::memory_order_relaxed);
+    elapsedSec_.store(0.0f, std::memory_order_relaxed);
+    for (const auto& [pid, slot] : slotOf_) {
+        (void)pid;
+        ClearSlot(slot);
+    }
+    EndWrite();
+}
+
+void MatchStats::AddPlayer(PlayerId playerId, Team team) {
+    if (SlotOf(playerId) >= 0) {
+        // Already in the match (re-add or team change): keep their stats.
+        SetPlayerTeam(playerId, team);
+        return;
+    }
+    if (freeSlots_ == 0) return;  // match is full; player is not tracked
+    int slot = 0;
+    while (!(freeSlots_ & (1ull << slot))) ++slot;
+    freeSlots_ &= ~(1ull << slot);
+    slotOf_[playerId] = slot;
+    BeginWrite();
+    slotPlayer_[slot].store(playerId, std::memory_order_relaxed);
+    slotTeam_[slot].store(static_cast<uint8_t>(team), std::memory_order_relaxed);
+    ClearSlot(slot);
+    EndWrite();
+}
+
+void MatchStats::RemovePlayer(PlayerId playerId) {
+    int slot = SlotOf(playerId);
+    if (slot < 0) return;
+    slotOf_.erase(playerId);
+    freeSlots_ |= 1ull << slot;
+    BeginWrite();
+    slotPlayer_[slot].store(0, std::memory_order_relaxed);
+    slotTeam_[slot].store(0, std::memory_order_relaxed);
+    EndWrite();
+}
+
+void MatchStats::SetPlayerTeam(PlayerId playerId, Team team) {
+    int slot = SlotOf(playerId);
+    if (slot < 0) return;
+    BeginWrite();
+    slotTeam_[slot].store(static_cast<uint8_t>(team), std::memory_order_relaxed);
+    EndWrite();
+}
+
+void MatchStats::AdvanceTime(float deltaSec) {
+    BeginWrite();
+    elapsedSec_.store(elapsedSec_.load(std::memory_order_relaxed) + deltaSec, std::memory_order_relaxed);
+    EndWrite();
+}
+
+void MatchStats::RecordKill(PlayerId killerId, PlayerId victimId) {
+    int killer = SlotOf(killerId);
+    int victim = SlotOf(victimId);
+    if (killer < 0 && victim < 0) return;
+    BeginWrite();
+    if (killer >= 0) {
+        Bump(kills_, killer);
+        Bump(streak_, killer);
+        int32_t streak = streak_[killer].load(std::memory_order_relaxed);
+        if (streak > bestStreak_[killer].load(std::memory_order_relaxed))
+            Store(bestStreak_, killer, streak);
+    }
+    if (victim >= 0) {
+        Bump(deaths_, victim);
+        Store(streak_, victim, 0);
+    }
+    EndWrite();
+}
+
+void MatchStats::RecordZombieKill(PlayerId killerId) {
+    int slot = SlotOf(killerId);
+    if (slot < 0) return;
+    BeginWrite();
+    Bump(zombieKills_, slot);
+    EndWrite();
+}
+
+void MatchStats::RecordFlagCapture(PlayerId playerId) {
+    int slot = SlotOf(playerId);
+    if (slot < 0) return;
+    BeginWrite();
+    Bump(captures_, slot);
+    EndWrite();
+}
+
+void MatchStats::RecordBombPlant(PlayerId playerId) {
+    int slot = SlotOf(playerId);
+    if (slot < 0) return;
+    BeginWrite();
+    Bump(plants_, slot);
+    EndWrite();
+}
+
+void MatchStats::RecordBombDefuse(PlayerId playerId) {
+    int slot = SlotOf(playerId);
+    if (slot < 0) return;
+    BeginWrite();
+    Bump(defuses_, slot);
+    EndWrite();
+}
+
+void MatchStats::ReadSnapshot(MatchStatsSnapshot& out) const {
+    for (;;) {
+        uint32_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1u) continue;  // writer mid-update
+
+        out.matchSeq = matchSeq_.load(std::memory_order_relaxed);
+        out.mode = static_cast<GameMode>(mode_.load(std::memory_order_relaxed));
+        out.elapsedSec = elapsedSec_.load(std::memory_order_relaxed);
+        out.playerCount = 0;
+        for (int i = 0; i < kMaxMatchSlots; ++i) {
+            PlayerId pid = slotPlayer_[i].load(std::memory_order_relaxed);
+            if (pid == 0) continue;
+            PlayerMatchStats& p = out.players[static_cast<size_t>(out.playerCount++)];
+            p.playerId = pid;
+            p.team = static_cast<Team>(slotTeam_[i].load(std::memory_order_relaxed));
+            p.kills = kills_[i].load(std::memory_order_relaxed);
+            p.deaths = deaths_[i].load(std::memory_order_relaxed);
+            p.streak = streak_[i].load(std::memory_order_relaxed);
+            p.bestStreak = bestStreak_[i].load(std::memory_order_relaxed);
+            p.captures = captures_[i].load(std::memory_order_relaxed);
+            p.plants = plants_[i].load(std::memory_order_relaxed);
+            p.defuses = defuses_[i].load(std::memory_order_relaxed);
+            p.zombieKills = zombieKills_[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == before) return;
+    }
+}
+
+MatchSummaryRecord MatchStats::BuildSummary(Team winner) const {
+    MatchSummaryRecord rec;
+    rec.matchSeq = matchSeq_.load(std::memory_order_relaxed);
+    rec.mode = static_cast<GameMode>(mode_.load(std::memory_order_relaxed));
+    rec.winner = winner;
+    rec.durationSec = elapsedSec_.load(std::memory_order_relaxed);
+    rec.players.reserve(slotOf_.size());
+    for (int i = 0; i < kMaxMatchSlots; ++i) {
+        PlayerId pid = slotPlayer_[i].load(std::memory_order_relaxed);
+        if (pid == 0) continue;
+        MatchSummaryEntry e;
+        e.playerId = pid;
+        e.team = slotTeam_[i].load(std::memory_order_relaxed);
+        e.kills = Saturate<uint16_t>(kills_[i].load(std::memory_order_relaxed));
+        e.deaths = Saturate<uint16_t>(deaths_[i].load(std::memory_order_relaxed));
+        e.bestStreak = Saturate<uint16_t>(bestStreak_[i].load(std::memory_order_relaxed));
+        e.zombieKills = Saturate<uint16_t>(zombieKills_[i].load(std::memory_order_relaxed));
+        e.captures = Saturate<uint8_t>(captures_[i].load(std::memory_order_relaxed));
+        e.plants = Saturate<uint8_t>(plants_[i].load(std::memory_order_relaxed));
+        e.defuses = Saturate<uint8_t>(defuses_[i].load(std::memory_order_relaxed));
+        rec.players.push_back(e);
+    }
+    return rec;
+}
+
+} // namespace game
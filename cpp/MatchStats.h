@@ -0,0 +1,116 @@
+#pragma once
+
+#include "GameTypes.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Per-match player statistics.
+// Counters live in per-slot arrays (one array per stat). The sim thread is the
+// only writer and never locks; API threads read a consistent copy through a
+// seqlock (ReadSnapshot retries while a write is in flight).
+// ---------------------------------------------------------------------------
+inline constexpr int kMaxMatchSlots = 64;
+
+struct PlayerMatchStats {
+    PlayerId playerId = 0;
+    Team team = Team::None;
+    int32_t kills = 0;
+    int32_t deaths = 0;
+    int32_t streak = 0;
+    int32_t bestStreak = 0;
+    int32_t captures = 0;
+    int32_t plants = 0;
+    int32_t defuses = 0;
+    int32_t zombieKills = 0;
+};
+
+struct MatchStatsSnapshot {
+    uint32_t matchSeq = 0;
+    GameMode mode = GameMode::None;
+    float elapsedSec = 0.0f;
+    int playerCount = 0;
+    std::array<PlayerMatchStats, kMaxMatchSlots> players{};
+};
+
+// End-of-match record: 16 bytes per player, counters saturate.
+struct MatchSummaryEntry {
+    PlayerId playerId = 0;
+    uint16_t kills = 0;
+    uint16_t deaths = 0;
+    uint16_t bestStreak = 0;
+    uint16_t zombieKills = 0;
+    uint8_t team = 0;
+    uint8_t captures = 0;
+    uint8_t plants = 0;
+    uint8_t defuses = 0;
+};
+static_assert(sizeof(MatchSummaryEntry) == 16, "MatchSummaryEntry must stay compact");
+
+struct MatchSummaryRecord {
+    uint32_t matchSeq = 0;
+    GameMode mode = GameMode::None;
+    Team winner = Team::None;
+    float durationSec = 0.0f;
+    std::vector<MatchSummaryEntry> players;
+};
+
+class MatchStats {
+public:
+    MatchStats();
+
+    // ---- Sim thread ----
+    void BeginMatch(GameMode mode);
+    void AddPlayer(PlayerId playerId, Team team);
+    void RemovePlayer(PlayerId playerId);
+    void SetPlayerTeam(PlayerId playerId, Team team);
+    void AdvanceTime(float deltaSec);
+
+    void RecordKill(PlayerId killerId, PlayerId victimId);
+    void RecordZombieKill(PlayerId killerId);
+    void RecordFlagCapture(PlayerId playerId);
+    void RecordBombPlant(PlayerId playerId);
+    void RecordBombDefuse(PlayerId playerId);
+
+    MatchSummaryRecord BuildSummary(Team winner) const;
+
+    // ---- Any thread ----
+    void ReadSnapshot(MatchStatsSnapshot& out) const;
+
+private:
+    using Counter = std::array<std::atomic<int32_t>, kMaxMatchSlots>;
+
+    int SlotOf(PlayerId playerId) const;
+    void BeginWrite();
+    void EndWrite();
+    void ClearSlot(int slot);
+    static void Bump(Counter& c, int slot, int32_t delta = 1);
+    static void Store(Counter& c, int slot, int32_t value);
+
+    // Sim-thread bookkeeping
+    std::unordered_map<PlayerId, int> slotOf_;
+    uint64_t freeSlots_ = ~0ull;
+
+    // Seqlock-published state
+    std::atomic<uint32_t> seq_{ 0 };
+    std::atomic<uint32_t> matchSeq_{ 0 };
+    std::atomic<uint8_t> mode_{ 0 };
+    std::atomic<float> elapsedSec_{ 0.0f };
+    std::array<std::atomic<PlayerId>, kMaxMatchSlots> slotPlayer_;
+    std::array<std::atomic<uint8_t>, kMaxMatchSlots> slotTeam_;
+    Counter kills_;
+    Counter deaths_;
+    Counter streak_;
+    Counter bestStreak_;
+    Counter captures_;
+    Counter plants_;
+    Counter defuses_;
+    Counter zombieKills_;
+};
+
+} // namespace game
@@ -0,0 +1,179 @@
+#include "Matchmaking.h"
+#include "GameServer.h"
+#include <algorithm>
+
+namespace game {
+
+int32_t Matchmaker::BucketOf(int32_t rating) const {
+    int32_t w = std::max<int32_t>(1, config_.skillBucketWidth);
+    return rating >= 0 ? rating / w : -((-rating + w - 1) / w);
+}
+
+int32_t Matchmaker::SkillWindow(double waitedSec) const {
+    double grown = config_.baseSkillWindow + std::max(0.0, waitedSec) * config_.windowGrowthPerSec;
+    return static_cast<int32_t>(std::min<double>(grown, config_.maxSkillWindow));
+}
+
+bool Matchmaker::Enqueue(PlayerId playerId, GameMode mode, int32_t rating, double nowSec, uint32_t partyId) {
+    if (mode == GameMode::None || tickets_.count(playerId)) return false;
+    Ticket t;
+    t.mode = mode;
+    t.rating = rating;
+    t.partyId = partyId;
+    t.seq = nextSeq_++;
+    t.enqueuedAt = nowSec;
+
+    ModeQueue& q = queues_[static_cast<int>(mode)];
+    q.bySkill.insert({ BucketOf(rating), t.seq, playerId });
+    q.byWait.emplace(t.seq, playerId);
+    tickets_.emplace(playerId, t);
+    if (partyId != 0)
+        parties_[partyId].push_back(playerId);
+    return true;
+}
+
+void Matchmaker::Remove(PlayerId playerId, const Ticket& ticket) {
+    ModeQueue& q = queues_[static_cast<int>(ticket.mode)];
+    q.bySkill.erase({ BucketOf(ticket.rating), ticket.seq, playerId });
+    q.byWait.erase(ticket.seq);
+    if (ticket.partyId == 0) return;
+    auto pit = parties_.find(ticket.partyId);
+    if (pit == parties_.end()) return;
+    auto& members = pit->second;
+    members.erase(std::remove(members.begin(), members.end(), playerId), members.end());
+    if (members.empty()) parties_.erase(pit);
+}
+
+void Matchmaker::TakeCandidate(GameMode mode, const BucketKey& key, size_t need) {
+    for (const auto& c : candidates_)
+        if (c.playerId == key.playerId) return;
+
+    const Ticket& t = tickets_.at(key.playerId);
+    if (t.partyId == 0) {
+        candidates_.push_back(key);
+        return;
+    }
+
+    // Whole party or nobody (members queued for another mode stay behind).
+    const auto& members = parties_.at(t.partyId);
+    size_t add = 0;
+    for (PlayerId m : members)
+        if (tickets_.at(m).mode == mode) ++add;
+    if (candidates_.size() + add > need) return;
+    for (PlayerId m : members) {
+        const Ticket& mt = tickets_.at(m);
+        if (mt.mode == mode)
+            candidates_.push_back({ BucketOf(mt.rating), mt.seq, m });
+    }
+}
+
+bool Matchmaker::Dequeue(PlayerId playerId) {
+    auto it = tickets_.find(playerId);
+    if (it == tickets_.end()) return false;
+    Remove(playerId, it->second);
+    tickets_.erase(it);
+    return true;
+}
+
+size_t Matchmaker::QueueSize(GameMode mode) const {
+    return queues_[static_cast<int>(mode)].byWait.size();
+}
+
+bool Matchmaker::TryFormLobby(GameMode mode, ModeQueue& queue, PlayerId seedId, double nowSec, Lobby& lobby) {
+    const Ticket& seed = tickets_.at(seedId);
+    double waited = nowSec - seed.enqueuedAt;
+    int32_t window = SkillWindow(waited);
+    int32_t center = BucketOf(seed.rating);
+    int32_t lo = BucketOf(seed.rating - window);
+    int32_t hi = BucketOf(seed.rating + window);
+    size_t need = static_cast<size_t>(std::max(2, config_.lobbySize));
+
+    auto takeBucket = [&](int32_t bucket) {
+        for (auto it = queue.bySkill.lower_bound({ bucket, 0, 0 });
+             it != queue.bySkill.end() && it->bucket == bucket && candidates_.size() < need; ++it)
+            TakeCandidate(mode, *it, need);
+    };
+
+    candidates_.clear();
+    TakeCandidate(mode, { center, seed.seq, seedId }, need);
+    if (candidates_.empty())
+        candidates_.push_back({ center, seed.seq, seedId });  // party larger than a lobby
+    takeBucket(center);
+    for (int32_t d = 1; candidates_.size() < need && (center - d >= lo || center + d <= hi); ++d) {
+        if (center - d >= lo) takeBucket(center - d);
+        if (center + d <= hi) takeBucket(center + d);
+    }
+
+    if (candidates_.size() < need) {
+        bool relaxed = waited >= config_.relaxAfterSec &&
+                       candidates_.size() >= static_cast<size_t>(std::max(2, config_.minLobbySize));
+        if (!relaxed) return false;
+    }
+
+    lobby = Lobby{};
+    lobby.id = nextLobbyId_++;
+    lobby.mode = mode;
+    lobby.players.reserve(candidates_.size());
+    lobby.ratings.reserve(candidates_.size());
+    lobby.partyIds.reserve(candidates_.size());
+    int32_t minRating = seed.rating, maxRating = seed.rating;
+    for (const auto& c : candidates_) {
+        auto tit = tickets_.find(c.playerId);
+        int32_t rating = tit->second.rating;
+        minRating = std::min(minRating, rating);
+        maxRating = std::max(maxRating, rating);
+        lobby.players.push_back(c.playerId);
+        lobby.ratings.push_back(rating);
+        lobby.partyIds.push_back(tit->second.partyId);
+        Remove(c.playerId, tit->second);
+        tickets_.erase(tit);
+    }
+    lobby.ratingSpread = maxRating - minRating;
+    AssignTeams(lobby);
+    return true;
+}
+
+void Matchmaker::AssignTeams(Lobby& lobby) {
+    lobby.teams.assign(lobby.players.size(), Team::None);
+    if (lobby.mode == GameMode::Zombies) return;  // co-op
+
+    balanceMembers_.resize(lobby.players.size());
+    for (size_t i = 0; i < lobby.players.size(); ++i)
+        balanceMembers_[i] = { lobby.players[i], lobby.ratings[i], lobby.partyIds[i] };
+    balancer_.Solve(balanceMembers_, split_);
+    lobby.teams = split_.teams;
+    lobby.teamRatingDiff = split_.ratingDiff;
+}
+
+int Matchmaker::FormLobbies(double nowSec, std::vector<Lobby>& out, int maxLobbies) {
+    int formed = 0;
+    for (int m = 1; m < kModeCount && formed < maxLobbies; ++m) {
+        GameMode mode = static_cast<GameMode>(m);
+        ModeQueue& queue = queues_[m];
+        int failedSeeds = 0;
+        auto it = queue.byWait.begin();
+        while (it != queue.byWait.end() && formed < maxLobbies &&
+               failedSeeds < config_.maxSeedAttemptsPerCall &&
+               queue.byWait.size() >= static_cast<size_t>(std::max(2, config_.minLobbySize))) {
+            uint64_t seedSeq = it->first;
+            Lobby lobby;
+            if (TryFormLobby(mode, queue, it->second, nowSec, lobby)) {
+                out.push_back(std::move(lobby));
+                ++formed;
+                it = queue.byWait.upper_bound(seedSeq);
+            } else {
+                ++failedSeeds;
+                ++it;
+            }
+        }
+    }
+    return formed;
+}
+
+void Matchmaker::StartLobby(GameServer& server, const Lobby& lobby) {
+    server.SetGameMode(lobby.mode);
+    for (size_t i = 0; i < lobby.players.size(); ++i)
+        server.AddPlayer(lobby.players[i], lobby.teams[i]);
+}
+
+} // namespace game
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "TeamBalance.h"
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+class GameServer;
+
+// ---------------------------------------------------------------------------
+// Native matchmaking (replaces checkMatchmaking in game-server/server.js).
+// Each mode keeps its queue in skill buckets; inside a bucket tickets are
+// ordered by wait time. The oldest ticket seeds a lobby and candidates are
+// pulled from its bucket outward, within a skill window that widens the
+// longer the seed has waited. All lookups are O(log n). Queued party members
+// are pulled into a lobby together and TeamBalancer splits the lobby.
+// ---------------------------------------------------------------------------
+inline constexpr int kMaxLobbySize = 10;  // 5v5
+inline constexpr int kModeCount = static_cast<int>(GameMode::Zombies) + 1;
+
+struct MatchmakingConfig {
+    int lobbySize = kMaxLobbySize;
+    int minLobbySize = 2;              // accepted once the seed has waited relaxAfterSec
+    float relaxAfterSec = 60.0f;
+    int32_t skillBucketWidth = 50;
+    int32_t baseSkillWindow = 100;     // +/- rating around the seed
+    float windowGrowthPerSec = 10.0f;
+    int32_t maxSkillWindow = 600;
+    int maxSeedAttemptsPerCall = 32;   // seeds tried per FormLobbies call before giving up
+};
+
+struct Lobby {
+    uint32_t id = 0;
+    GameMode mode = GameMode::None;
+    std::vector<PlayerId> players;
+    std::vector<int32_t> ratings;
+    std::vector<uint32_t> partyIds;
+    std::vector<Team> teams;
+    int32_t ratingSpread = 0;
+    int64_t teamRatingDiff = 0;  // |sum(Alpha) - sum(Bravo)|
+};
+
+class Matchmaker {
+public:
+    explicit Matchmaker(MatchmakingConfig config = MatchmakingConfig{}) : config_(config) {}
+
+    bool Enqueue(PlayerId playerId, GameMode mode, int32_t rating, double nowSec, uint32_t partyId = 0);
+    bool Dequeue(PlayerId playerId);
+    bool IsQueued(PlayerId playerId) const { return tickets_.count(playerId) != 0; }
+    size_t QueueSize(GameMode mode) const;
+
+    // Forms up to maxLobbies lobbies across all modes; appends them to out.
+    int FormLobbies(double nowSec, std::vector<Lobby>& out,
+                    int maxLobbies = std::numeric_limits<int>::max());
+
+    // Hands a lobby to a server with no match in progress: sets the mode and
+    // adds every player on their assigned team.
+    static void StartLobby(GameServer& server, const Lobby& lobby);
+
+    const MatchmakingConfig& Config() const { return config_; }
+
+private:
+    struct Ticket {
+        GameMode mode = GameMode::None;
+        int32_t rating = 0;
+        uint32_t partyId = 0;
+        uint64_t seq = 0;
+        double enqueuedAt = 0.0;
+    };
+
+    struct BucketKey {
+        int32_t bucket;
+        uint64_t seq;
+        PlayerId playerId;
+        bool operator<(const BucketKey& o) const {
+            return bucket != o.bucket ? bucket < o.bucket : seq < o.seq;
+        }
+    };
+
+    struct ModeQueue {
+        std::set<BucketKey> bySkill;
+        std::map<uint64_t, PlayerId> byWait;
+    };
+
+    int32_t BucketOf(int32_t rating) const;
+    int32_t SkillWindow(double waitedSec) const;
+    bool TryFormLobby(GameMode mode, ModeQueue& queue, PlayerId seedId, double nowSec, Lobby& lobby);
+    void TakeCandidate(GameMode mode, const BucketKey& key, size_t need);
+    void AssignTeams(Lobby& lobby);
+    void Remove(PlayerId playerId, const Ticket& ticket);
+
+    MatchmakingConfig config_;
+    ModeQueue queues_[kModeCount];
+    std::unordered_map<PlayerId, Ticket> tickets_;
+    std::unordered_map<uint32_t, std::vector<PlayerId>> parties_;  // queued members per party
+    std::vector<BucketKey> candidates_;
+    TeamBalancer balancer_;
+    std::vector<BalanceMember> balanceMembers_;
+    TeamSplit split_;
+    uint64_t nextSeq_ = 1;
+    uint32_t nextLobbyId_ = 1;
+};
+
+} // namespace game
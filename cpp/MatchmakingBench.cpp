@@ -0,0 +1,159 @@
+/**
+ * Virtual Sim — Matchmaking benchmark
+ * Keeps 100k players queued (refilling as lobbies form) and measures lobby
+ * formation latency, plus the hand-off cost into a fresh GameServer and the
+ * team-balancing solver at 5v5 (solo and with parties) and 32v32.
+ *
+ * Usage: matchmaking_bench [--queued N] [--lobbies N]
+ */
+
+#include "Matchmaking.h"
+#include "GameServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace game;
+
+using Clock = std::chrono::steady_clock;
+
+static const GameMode kQueueModes[] = {
+    GameMode::TeamDeathmatch, GameMode::Domination, GameMode::CaptureTheFlag, GameMode::SearchAndDestroy,
+};
+
+int main(int argc, char** argv) {
+    int queued = 100000;
+    int lobbies = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--queued") == 0) queued = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--lobbies") == 0) lobbies = std::atoi(argv[i + 1]);
+    }
+    lobbies = std::max(lobbies, 1);
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> skill(1500.0f, 300.0f);
+    std::uniform_int_distribution<int> modePick(0, 3);
+    PlayerId nextPlayer = 1;
+    double now = 0.0;
+
+    Matchmaker mm;
+    queued = std::max(queued, mm.Config().minLobbySize);  // fewer can never form a lobby
+    auto enqueueOne = [&]() {
+        GameMode mode = kQueueModes[modePick(rng)];
+        mm.Enqueue(nextPlayer++, mode, static_cast<int32_t>(skill(rng)), now);
+    };
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < queued; ++i) enqueueOne();
+    double enqueueUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+
+    std::vector<double> samplesUs;
+    samplesUs.reserve(static_cast<size_t>(lobbies));
+    std::vector<Lobby> formed;
+    long long spreadSum = 0;
+    size_t playersMatched = 0;
+
+    // Once every seed has waited past full window growth and the relaxed
+    // lobby size, an empty queue round can no longer change; give up then.
+    const MatchmakingConfig& config = mm.Config();
+    const int maxIdleSec = static_cast<int>(config.relaxAfterSec +
+        static_cast<float>(config.maxSkillWindow - config.baseSkillWindow) / config.windowGrowthPerSec) + 2;
+    int idleSec = 0;
+    bool stalled = false;
+
+    while (static_cast<int>(samplesUs.size()) < lobbies) {
+        formed.clear();
+        auto start = Clock::now();
+        int n = mm.FormLobbies(now, formed, 1);
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        if (n == 0) {
+            if (++idleSec > maxIdleSec) {
+                stalled = true;
+                break;
+            }
+            now += 1.0;  // nothing fits yet; let skill windows widen
+            continue;
+        }
+        idleSec = 0;
+        samplesUs.push_back(us);
+        for (const auto& lobby : formed) {
+            spreadSum += lobby.ratingSpread;
+            playersMatched += lobby.players.size();
+            for (size_t i = 0; i < lobby.players.size(); ++i) enqueueOne();  // hold the queue at size
+        }
+        now += 0.001;
+    }
+
+    // Hand-off into servers (a subset; GameServer construction dominates otherwise).
+    std::vector<Lobby> handoff;
+    mm.FormLobbies(now, handoff, 1000);
+    std::vector<std::unique_ptr<GameServer>> servers;
+    servers.reserve(handoff.size());
+    for (size_t i = 0; i < handoff.size(); ++i) servers.push_back(std::make_unique<GameServer>());
+    auto h0 = Clock::now();
+    for (size_t i = 0; i < handoff.size(); ++i) Matchmaker::StartLobby(*servers[i], handoff[i]);
+    double handoffUs = handoff.empty() ? 0.0
+        : std::chrono::duration<double, std::micro>(Clock::now() - h0).count() / handoff.size();
+
+    // Team balancing: exact at 5v5, heuristic for big lobbies.
+    struct BalanceCase {
+        const char* name;
+        int players;
+        int partySize;
+    };
+    const BalanceCase cases[] = { { "5v5 solo", 10, 1 }, { "5v5 parties", 10, 3 }, { "32v32 parties", 64, 4 } };
+    TeamBalancer balancer;
+    TeamSplit split;
+    std::vector<BalanceMember> members;
+    double balanceUs[3] = {};
+    double balanceDiff[3] = {};
+    const int balanceRuns = 20000;
+    for (int c = 0; c < 3; ++c) {
+        double total = 0.0;
+        for (int run = 0; run < balanceRuns; ++run) {
+            members.resize(static_cast<size_t>(cases[c].players));
+            for (int i = 0; i < cases[c].players; ++i) {
+                uint32_t party = (cases[c].partySize > 1 && i < cases[c].players / 2)
+                    ? static_cast<uint32_t>(1 + i / cases[c].partySize) : 0;
+                members[static_cast<size_t>(i)] = { static_cast<PlayerId>(i + 1), static_cast<int32_t>(skill(rng)), party };
+            }
+            auto b0 = Clock::now();
+            balancer.Solve(members, split);
+            total += std::chrono::duration<double, std::micro>(Clock::now() - b0).count();
+            balanceDiff[c] += static_cast<double>(split.ratingDiff);
+        }
+        balanceUs[c] = total / balanceRuns;
+        balanceDiff[c] /= balanceRuns;
+    }
+
+    if (stalled)
+        std::printf("stopped after %zu of %d lobbies: the queue cannot form another (try a larger --queued)\n",
+                    samplesUs.size(), lobbies);
+    std::vector<double> sorted = samplesUs;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double v : sorted) sum += v;
+    auto pct = [&](double p) { return sorted[static_cast<size_t>(p * (sorted.size() - 1))]; };
+
+    size_t stillQueued = 0;
+    for (GameMode m : kQueueModes) stillQueued += mm.QueueSize(m);
+
+    std::printf("queued players:       %zu\n", stillQueued);
+    std::printf("enqueue:              %.3f us/player\n", enqueueUs / queued);
+    std::printf("lobbies formed:       %zu (%zu players)\n", sorted.size(), playersMatched);
+    if (!sorted.empty()) {
+        std::printf("lobby formation:      mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n",
+                    sum / sorted.size(), pct(0.50), pct(0.99), sorted.back());
+        std::printf("mean rating spread:   %.1f\n", static_cast<double>(spreadSum) / sorted.size());
+    }
+    std::printf("GameServer hand-off:  %.2f us/lobby (%zu lobbies)\n", handoffUs, handoff.size());
+    for (int c = 0; c < 3; ++c)
+        std::printf("balance %-13s %.2f us/solve, mean team rating diff %.1f\n",
+                    cases[c].name, balanceUs[c], balanceDiff[c]);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "Mission.h"
+#include "Analytics.h"
 #include <algorithm>
 #include <chrono>
 #include <utility>
@@ -6,7 +7,11 @@
 namespace game {
 
 void MissionSystem::RegisterMission(MissionDefinition def) {
-    if (def.id == 0) return;
+    if (def.id == 0 || def.objectives.size() > kMaxMissionObjectives) return;
+    for (auto& obj : def.objectives) {
+        obj.targetSymbol = InternSymbol(obj.targetTag);
+        if (obj.targetSymbol == kNoSymbol) return;  // hash collision with another tag
+    }
     missions_[def.id] = std::move(def);
 }
 
@@ -33,17 +38,26 @@ bool MissionSystem::StartMission(PlayerId playerId, MissionId missionId) {
     const MissionDefinition* def = GetMission(missionId);
     if (!def) return false;
 
-    MissionInstance inst;
+    // Restarting (or a chained start of a mission run before) reuses the
+    // player's existing instance in place.
+    MissionInstance& inst = playerMissions_[playerId][missionId];
     inst.missionId = missionId;
     inst.state = MissionState::Active;
+    inst.objectiveCount = static_cast<uint8_t>(def->objectives.size());
+    inst.completedMask = 0;
     inst.currentObjectiveIndex = 0;
-    inst.objectives = def->objectives;
+    for (size_t i = 0; i < def->objectives.size(); ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        inst.progress[i] = obj.progress;
+        inst.timeLeftSec[i] = obj.timeLimitSec;
+        if (obj.completed) inst.SetCompleted(i);
+    }
     inst.startedAt = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::steady_clock::now().time_since_epoch()).count());
 
-    playerMissions_[playerId][missionId] = std::move(inst);
     playerActiveMission_[playerId] = missionId;
 
+    RecordProgress(playerId, inst);
     if (onMissionEvent_)
         onMissionEvent_(playerId, missionId, MissionState::Active);
     return true;
@@ -55,19 +69,35 @@ void MissionSystem::FailMission(PlayerId playerId, MissionId missionId) {
     inst->state = MissionState::Failed;
     if (playerActiveMission_[playerId] == missionId)
         playerActiveMission_.erase(playerId);
+    RecordProgress(playerId, *inst);
     if (onMissionEvent_)
         onMissionEvent_(playerId, missionId, MissionState::Failed);
 }
 
+void MissionSystem::RecordProgress(PlayerId playerId, const MissionInstance& inst) {
+    if (analytics_)
+        analytics_->Record(analyticsProducer_, ProgressionKind::Mission, playerId, inst.missionId,
+                           static_cast<uint8_t>(inst.state), inst.currentObjectiveIndex);
+}
+
+size_t MissionSystem::ObjectiveCount(const MissionInstance& inst, const MissionDefinition& def) {
+    // A mission re-registered while instances run keeps them on the
+    // objectives both layouts have.
+    return std::min<size_t>(inst.objectiveCount, def.objectives.size());
+}
+
 void MissionSystem::UpdateObjectiveProgress(PlayerId playerId, MissionId missionId, ObjectiveId objectiveId, int32_t delta) {
     MissionInstance* inst = GetPlayerMission(playerId, missionId);
     if (!inst || inst->state != MissionState::Active) return;
+    const MissionDefinition* def = GetMission(missionId);
+    if (!def) return;
 
-    for (auto& obj : inst->objectives) {
-        if (obj.id == objectiveId && !obj.completed) {
-            obj.progress = std::max(0, std::min(obj.target, obj.progress + delta));
-            if (obj.progress >= obj.target) {
-                obj.completed = true;
+    for (size_t i = 0, n = ObjectiveCount(*inst, *def); i < n; ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.id == objectiveId && !inst->Completed(i)) {
+            inst->progress[i] = std::max(0, std::min(obj.target, inst->progress[i] + delta));
+            if (inst->progress[i] >= obj.target) {
+                inst->SetCompleted(i);
                 AdvanceMission(playerId, missionId);
             }
             return;
@@ -78,11 +108,14 @@ void MissionSystem::UpdateObjectiveProgress(PlayerId playerId, MissionId mission
 void MissionSystem::CompleteObjective(PlayerId playerId, MissionId missionId, ObjectiveId objectiveId) {
     MissionInstance* inst = GetPlayerMission(playerId, missionId);
     if (!inst || inst->state != MissionState::Active) return;
+    const MissionDefinition* def = GetMission(missionId);
+    if (!def) return;
 
-    for (auto& obj : inst->objectives) {
-        if (obj.id == objectiveId && !obj.completed) {
-            obj.completed = true;
-            obj.progress = obj.target;
+    for (size_t i = 0, n = ObjectiveCount(*inst, *def); i < n; ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.id == objectiveId && !inst->Completed(i)) {
+            inst->SetCompleted(i);
+            inst->progress[i] = obj.target;
             AdvanceMission(playerId, missionId);
             return;
         }
@@ -94,7 +127,7 @@ void MissionSystem::AdvanceMission(PlayerId playerId, MissionId missionId) {
     if (!inst || inst->state != MissionState::Active) return;
 
     size_t next = static_cast<size_t>(inst->currentObjectiveIndex);
-    while (next < inst->objectives.size() && inst->objectives[next].completed)
+    while (next < inst->objectiveCount && inst->Completed(next))
         ++next;
     inst->currentObjectiveIndex = static_cast<int32_t>(next);
 
@@ -105,18 +138,12 @@ void MissionSystem::CheckMissionSuccess(PlayerId playerId, MissionId missionId)
     MissionInstance* inst = GetPlayerMission(playerId, missionId);
     if (!inst || inst->state != MissionState::Active) return;
 
-    bool allDone = true;
-    for (const auto& obj : inst->objectives) {
-        if (!obj.completed) {
-            allDone = false;
-            break;
-        }
-    }
-
-    if (allDone) {
+    const uint32_t allDone = (1u << inst->objectiveCount) - 1u;
+    if ((inst->completedMask & allDone) == allDone) {
         inst->state = MissionState::Success;
         if (playerActiveMission_[playerId] == missionId)
             playerActiveMission_.erase(playerId);
+        RecordProgress(playerId, *inst);
         if (onMissionEvent_)
             onMissionEvent_(playerId, missionId, MissionState::Success);
 
@@ -126,36 +153,74 @@ void MissionSystem::CheckMissionSuccess(PlayerId playerId, MissionId missionId)
     }
 }
 
-void MissionSystem::NotifyKill(PlayerId playerId, const std::string& targetTag) {
+void MissionSystem::ApplyKill(PlayerId playerId, MissionInstance& inst, SymbolId targetTag) {
+    const MissionDefinition* def = GetMission(inst.missionId);
+    if (!def) return;
+    for (size_t i = 0, n = ObjectiveCount(inst, *def); i < n; ++i) {
+        if (inst.state != MissionState::Active) return;
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.type != MissionObjectiveType::EliminateAll || inst.Completed(i) || obj.targetSymbol != targetTag)
+            continue;
+        inst.progress[i] = std::max(0, std::min(obj.target, inst.progress[i] + 1));
+        if (inst.progress[i] >= obj.target) {
+            inst.SetCompleted(i);
+            AdvanceMission(playerId, inst.missionId);
+        }
+    }
+}
+
+void MissionSystem::NotifyKill(PlayerId playerId, SymbolId targetTag) {
     MissionInstance* inst = GetActiveMission(playerId);
     if (!inst || inst->state != MissionState::Active) return;
-    for (auto& obj : inst->objectives)
-        if (obj.type == MissionObjectiveType::EliminateAll && obj.targetTag == targetTag && !obj.completed)
-            UpdateObjectiveProgress(playerId, inst->missionId, obj.id, 1);
+    ApplyKill(playerId, *inst, targetTag);
+}
+
+void MissionSystem::NotifyKills(PlayerId playerId, Span<const SymbolId> targetTags) {
+    MissionInstance* inst = GetActiveMission(playerId);
+    for (SymbolId targetTag : targetTags) {
+        // The active mission only changes when the current one resolves.
+        if (!inst || inst->state != MissionState::Active) {
+            inst = GetActiveMission(playerId);
+            if (!inst || inst->state != MissionState::Active) return;
+        }
+        ApplyKill(playerId, *inst, targetTag);
+    }
 }
 
-void MissionSystem::NotifyReachZone(PlayerId playerId, const std::string& zoneTag) {
+void MissionSystem::NotifyReachZone(PlayerId playerId, SymbolId zoneTag) {
     MissionInstance* inst = GetActiveMission(playerId);
     if (!inst || inst->state != MissionState::Active) return;
-    for (auto& obj : inst->objectives)
-        if (obj.type == MissionObjectiveType::ReachZone && obj.targetTag == zoneTag && !obj.completed)
+    const MissionDefinition* def = GetMission(inst->missionId);
+    if (!def) return;
+    for (size_t i = 0, n = ObjectiveCount(*inst, *def); i < n; ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.type == MissionObjectiveType::ReachZone && obj.targetSymbol == zoneTag && !inst->Completed(i))
             CompleteObjective(playerId, inst->missionId, obj.id);
+    }
 }
 
-void MissionSystem::NotifyInteract(PlayerId playerId, const std::string& objectTag) {
+void MissionSystem::NotifyInteract(PlayerId playerId, SymbolId objectTag) {
     MissionInstance* inst = GetActiveMission(playerId);
     if (!inst || inst->state != MissionState::Active) return;
-    for (auto& obj : inst->objectives)
-        if (obj.type == MissionObjectiveType::InteractWith && obj.targetTag == objectTag && !obj.completed)
+    const MissionDefinition* def = GetMission(inst->missionId);
+    if (!def) return;
+    for (size_t i = 0, n = ObjectiveCount(*inst, *def); i < n; ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.type == MissionObjectiveType::InteractWith && obj.targetSymbol == objectTag && !inst->Completed(i))
             CompleteObjective(playerId, inst->missionId, obj.id);
+    }
 }
 
 void MissionSystem::NotifyDefendProgress(PlayerId playerId, int32_t progress) {
     MissionInstance* inst = GetActiveMission(playerId);
     if (!inst || inst->state != MissionState::Active) return;
-    for (auto& obj : inst->objectives)
-        if (obj.type == MissionObjectiveType::Defend && !obj.completed)
-            UpdateObjectiveProgress(playerId, inst->missionId, obj.id, progress - obj.progress);
+    const MissionDefinition* def = GetMission(inst->missionId);
+    if (!def) return;
+    for (size_t i = 0, n = ObjectiveCount(*inst, *def); i < n; ++i) {
+        const MissionObjective& obj = def->objectives[i];
+        if (obj.type == MissionObjectiveType::Defend && !inst->Completed(i))
+            UpdateObjectiveProgress(playerId, inst->missionId, obj.id, progress - inst->progress[i]);
+    }
 }
 
 void MissionSystem::Tick(float deltaSec) {
@@ -163,10 +228,13 @@ void MissionSystem::Tick(float deltaSec) {
     for (auto& [playerId, missions] : playerMissions_) {
         for (auto& [missionId, inst] : missions) {
             if (inst.state != MissionState::Active) continue;
-            for (auto& obj : inst.objectives) {
-                if (obj.completed || obj.timeLimitSec <= 0.0f) continue;
-                obj.timeLimitSec -= deltaSec;
-                if (obj.timeLimitSec <= 0.0f)
+            const MissionDefinition* def = GetMission(missionId);
+            if (!def) continue;
+            for (size_t i = 0, n = ObjectiveCount(inst, *def); i < n; ++i) {
+                if (inst.Completed(i) || inst.timeLeftSec[i] <= 0.0f)
+                    continue;
+                inst.timeLeftSec[i] -= deltaSec;
+                if (inst.timeLeftSec[i] <= 0.0f)
                     toFail.emplace_back(playerId, missionId);
             }
         }
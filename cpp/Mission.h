@@ -1,18 +1,23 @@
 #pragma once
 
 #include "GameTypes.h"
+#include "Span.h"
 #include <unordered_map>
 #include <vector>
 #include <functional>
 
 namespace game {
 
+class ProgressionAnalytics;
+
 class MissionSystem {
 public:
     using MissionEventCallback = std::function<void(PlayerId, MissionId, MissionState)>;
 
     MissionSystem() = default;
 
+    // Ignored if the id is 0, there are more than kMaxMissionObjectives
+    // objectives or a target tag collides with another symbol.
     void RegisterMission(MissionDefinition def);
     const MissionDefinition* GetMission(MissionId id) const;
     MissionInstance* GetPlayerMission(PlayerId playerId, MissionId missionId);
@@ -23,9 +28,14 @@ public:
     void UpdateObjectiveProgress(PlayerId playerId, MissionId missionId, ObjectiveId objectiveId, int32_t delta);
     void CompleteObjective(PlayerId playerId, MissionId missionId, ObjectiveId objectiveId);
 
-    void NotifyKill(PlayerId playerId, const std::string& targetTag);
-    void NotifyReachZone(PlayerId playerId, const std::string& zoneTag);
-    void NotifyInteract(PlayerId playerId, const std::string& objectTag);
+    // Tags match by symbol id; the string forms hash their argument.
+    void NotifyKill(PlayerId playerId, SymbolId targetTag);
+    void NotifyKill(PlayerId playerId, std::string_view targetTag) { NotifyKill(playerId, SymbolHash(targetTag)); }
+    void NotifyKills(PlayerId playerId, Span<const SymbolId> targetTags);
+    void NotifyReachZone(PlayerId playerId, SymbolId zoneTag);
+    void NotifyReachZone(PlayerId playerId, std::string_view zoneTag) { NotifyReachZone(playerId, SymbolHash(zoneTag)); }
+    void NotifyInteract(PlayerId playerId, SymbolId objectTag);
+    void NotifyInteract(PlayerId playerId, std::string_view objectTag) { NotifyInteract(playerId, SymbolHash(objectTag)); }
     void NotifyDefendProgress(PlayerId playerId, int32_t progress);
     void Tick(float deltaSec);
 
@@ -33,15 +43,26 @@ public:
     MissionInstance* GetActiveMission(PlayerId playerId);
 
     void SetEventCallback(MissionEventCallback cb) { onMissionEvent_ = std::move(cb); }
+    // Start, fail and success events also go to analytics as `producer`,
+    // with the objective index the mission was on; nullptr detaches.
+    void SetAnalytics(ProgressionAnalytics* analytics, size_t producer) {
+        analytics_ = analytics;
+        analyticsProducer_ = producer;
+    }
 
 private:
     void AdvanceMission(PlayerId playerId, MissionId missionId);
     void CheckMissionSuccess(PlayerId playerId, MissionId missionId);
+    void ApplyKill(PlayerId playerId, MissionInstance& inst, SymbolId targetTag);
+    static size_t ObjectiveCount(const MissionInstance& inst, const MissionDefinition& def);
+    void RecordProgress(PlayerId playerId, const MissionInstance& inst);
 
     std::unordered_map<MissionId, MissionDefinition> missions_;
     std::unordered_map<PlayerId, std::unordered_map<MissionId, MissionInstance>> playerMissions_;
     std::unordered_map<PlayerId, MissionId> playerActiveMission_;
     MissionEventCallback onMissionEvent_;
+    ProgressionAnalytics* analytics_ = nullptr;
+    size_t analyticsProducer_ = 0;
 };
 
 } // namespace game
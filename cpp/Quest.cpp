@@ -1,205 +1,554 @@
 #include "Quest.h"
+#include "Analytics.h"
 #include <algorithm>
 #include <chrono>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace game {
 
-void QuestSystem::RegisterQuest(QuestDefinition def) {
-    if (def.id == 0) return;
-    quests_[def.id] = std::move(def);
+namespace {
+
+// Unix seconds: start times are persisted, so they must mean the same after
+// a restart (a steady clock restarts at boot).
+int64_t NowSeconds() {
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
-const QuestDefinition* QuestSystem::GetQuest(QuestId id) const {
-    auto it = quests_.find(id);
-    return it != quests_.end() ? &it->second : nullptr;
+uint32_t LowestSetBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return index;
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
 }
 
-QuestProgress* QuestSystem::GetPlayerProgress(PlayerId playerId, QuestId questId) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return nullptr;
-    auto qit = pit->second.find(questId);
-    return qit != pit->second.end() ? &qit->second : nullptr;
+bool TestBit(Span<const uint64_t> bits, uint32_t index) {
+    return index / 64 < bits.size() && ((bits[index / 64] >> (index % 64)) & 1u);
 }
 
-const QuestProgress* QuestSystem::GetPlayerProgress(PlayerId playerId, QuestId questId) const {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return nullptr;
-    auto qit = pit->second.find(questId);
-    return qit != pit->second.end() ? &qit->second : nullptr;
+bool SameObjectives(Span<const PackObjective> a, Span<const PackObjective> b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].id != b[i].id || a[i].type != b[i].type || a[i].targetSymbol != b[i].targetSymbol ||
+            a[i].target != b[i].target || a[i].initial != b[i].initial || a[i].optional != b[i].optional)
+            return false;
+    return true;
 }
 
-bool QuestSystem::MeetsPrerequisite(PlayerId playerId, QuestId questId) const {
-    const QuestDefinition* def = GetQuest(questId);
-    if (!def || def->prerequisiteQuestId == 0) return true;
-    const QuestProgress* prereq = GetPlayerProgress(playerId, def->prerequisiteQuestId);
-    return prereq && prereq->state == QuestState::Completed;
+} // namespace
+
+QuestSystem::QuestSystem() {
+    auto pack = std::make_shared<QuestPack>();
+    editable_ = pack.get();
+    pack_ = std::move(pack);
 }
 
-bool QuestSystem::StartQuest(PlayerId playerId, QuestId questId) {
-    const QuestDefinition* def = GetQuest(questId);
-    if (!def) return false;
-    if (!MeetsPrerequisite(playerId, questId)) return false;
+void QuestSystem::RegisterQuest(const QuestDefinition& def) {
+    if (!editable_) {
+        auto copy = pack_->Clone();
+        editable_ = copy.get();
+        pack_ = std::move(copy);
+    }
+    const uint32_t existing = DenseIndex(def.id);
+    if (existing != kNoQuest && !players_.empty()) {
+        // Replacing a quest players may hold: keep the old definitions aside
+        // and move player state the way UsePack does (counters by objective
+        // id, unlocked flags along the new prerequisite).
+        std::shared_ptr<const QuestPack> old = pack_->Clone();
+        if (editable_->Add(def)) RebindPlayers(*old);
+        return;
+    }
+    if (!editable_->Add(def)) return;
+    RefreshUnlocked(DenseIndex(def.id));
+}
 
-    QuestProgress* existing = GetPlayerProgress(playerId, questId);
-    if (existing && (existing->state == QuestState::InProgress || existing->state == QuestState::Available))
-        return false;
+void QuestSystem::UsePack(std::shared_ptr<const QuestPack> pack) {
+    if (!pack || pack == pack_) return;
+    std::shared_ptr<const QuestPack> old = std::move(pack_);
+    pack_ = std::move(pack);
+    editable_ = nullptr;
+    RebindPlayers(*old);
+}
+
+void QuestSystem::RebindPlayers(const QuestPack& old) {
+    const QuestPack& pack = *pack_;
+    std::vector<uint32_t> remap(old.QuestCount());
+    std::vector<uint8_t> layoutChanged(old.QuestCount(), 0);
+    bool structural = false;
+    for (uint32_t q = 0; q < old.QuestCount(); ++q) {
+        const uint32_t quest = pack.Find(old.Quest(q).id);
+        remap[q] = quest;
+        if (quest != q) structural = true;
+        if (quest == kNoQuest) continue;
+        layoutChanged[q] = !SameObjectives(old.Objectives(q), pack.Objectives(quest));
+        structural |= layoutChanged[q] || pack.Quest(quest).prerequisite != old.Quest(q).prerequisite;
+    }
+    for (uint32_t q = 0; q < pack.QuestCount() && !structural; ++q)
+        structural = pack.Quest(q).prerequisite != 0 && old.Find(pack.Quest(q).id) == kNoQuest;
+    if (!structural) return;
+    for (auto& [playerId, pq] : players_)
+        RebindPlayer(playerId, pq, old, remap, layoutChanged);
+}
+
+void QuestSystem::RebindPlayer(PlayerId playerId, PlayerQuests& pq, const QuestPack& old,
+                               const std::vector<uint32_t>& remap, const std::vector<uint8_t>& layoutChanged) {
+    PlayerQuests next;
+    // Unlocked flags are rebuilt by SetCompleted along the new edges.
+    for (size_t i = 0; i < pq.flagBlocks.size(); ++i) {
+        for (FlagPlane plane : { kCompletedPlane, kFailedPlane, kAbandonedPlane }) {
+            for (uint64_t bits = pq.flags[i * kPlaneCount + plane]; bits != 0; bits &= bits - 1) {
+                const uint32_t quest = remap[pq.flagBlocks[i] * 64 + LowestSetBit(bits)];
+                if (quest == kNoQuest) continue;
+                if (plane == kCompletedPlane)
+                    SetCompleted(next, quest, true);
+                else
+                    SetFlag(next, plane, quest, true);
+            }
+        }
+    }
+    for (const ActiveQuest& aq : pq.active) {
+        const uint32_t quest = remap[aq.quest];
+        if (quest == kNoQuest) continue;
+        BeginQuest(next, quest, aq.startedAt);
+        const Span<const PackObjective> before = old.Objectives(aq.quest);
+        const Span<const PackObjective> after = pack_->Objectives(quest);
+        ActiveObjective* entries = next.objectives.data() + (next.objectives.size() - after.size());
+        for (const ActiveObjective& obj : pq.objectives) {
+            if (obj.quest != aq.quest || obj.objective >= before.size()) continue;
+            for (size_t i = 0; i < after.size(); ++i)
+                if (after[i].id == before[obj.objective].id)
+                    entries[i].current = std::max(0, std::min(after[i].target, obj.current));
+        }
+        if (!layoutChanged[aq.quest]) continue;
+        // Restate the quest so counters dropped or clamped here are not
+        // revived from older records if their objective comes back.
+        Persist(playerId, quest, QuestLogOp::State, QuestState::InProgress, 0, static_cast<int32_t>(aq.startedAt));
+        for (size_t i = 0; i < after.size(); ++i)
+            if (entries[i].current != after[i].initial) PersistCounter(playerId, entries[i]);
+    }
+    pq = std::move(next);
+}
+
+void QuestSystem::RefreshUnlocked(uint32_t quest) {
+    const QuestId prereqId = pack_->Quest(quest).prerequisite;
+    const uint32_t prereq = prereqId != 0 ? DenseIndex(prereqId) : kNoQuest;
+    for (auto& [playerId, pq] : players_)
+        SetFlag(pq, kUnlockedPlane, quest, prereq != kNoQuest && TestFlag(pq, kCompletedPlane, prereq));
+}
+
+void QuestSystem::SetCompleted(PlayerQuests& pq, uint32_t quest, bool value) {
+    if (TestFlag(pq, kCompletedPlane, quest) == value) return;
+    SetFlag(pq, kCompletedPlane, quest, value);
+    for (uint32_t dependent : pack_->Dependents(quest))
+        SetFlag(pq, kUnlockedPlane, dependent, value);
+}
+
+SymbolId QuestSystem::MatchTarget(const PackObjective& obj) {
+    if (obj.type == QuestObjectiveType::SurviveRounds || obj.type == QuestObjectiveType::WinMatches)
+        return kAnyTarget;
+    return obj.targetSymbol;
+}
+
+const uint64_t* QuestSystem::FlagBlock(const PlayerQuests& pq, uint32_t block) {
+    // Players touch few blocks, so a scan beats a binary search.
+    for (size_t i = 0; i < pq.flagBlocks.size(); ++i)
+        if (pq.flagBlocks[i] == block) return &pq.flags[i * kPlaneCount];
+    return nullptr;
+}
 
+uint64_t* QuestSystem::FlagBlock(PlayerQuests& pq, uint32_t block) {
+    for (size_t i = 0; i < pq.flagBlocks.size(); ++i)
+        if (pq.flagBlocks[i] == block) return &pq.flags[i * kPlaneCount];
+    return nullptr;
+}
+
+bool QuestSystem::TestFlag(const PlayerQuests& pq, FlagPlane plane, uint32_t quest) {
+    const uint64_t* planes = FlagBlock(pq, quest / 64);
+    return planes && ((planes[plane] >> (quest % 64)) & 1u);
+}
+
+void QuestSystem::SetFlag(PlayerQuests& pq, FlagPlane plane, uint32_t quest, bool value) {
+    const uint32_t block = quest / 64;
+    uint64_t* planes = FlagBlock(pq, block);
+    if (!planes) {
+        if (!value) return;
+        auto pos = std::lower_bound(pq.flagBlocks.begin(), pq.flagBlocks.end(), block);
+        const size_t index = static_cast<size_t>(pos - pq.flagBlocks.begin());
+        pq.flagBlocks.insert(pos, block);
+        pq.flags.insert(pq.flags.begin() + static_cast<std::ptrdiff_t>(index * kPlaneCount), kPlaneCount, 0);
+        planes = &pq.flags[index * kPlaneCount];
+    }
+    const uint64_t bit = uint64_t{ 1 } << (quest % 64);
+    if (value)
+        planes[plane] |= bit;
+    else
+        planes[plane] &= ~bit;
+}
+
+const QuestSystem::PlayerQuests* QuestSystem::FindPlayer(PlayerId playerId) const {
+    auto it = players_.find(playerId);
+    return it != players_.end() ? &it->second : nullptr;
+}
+
+QuestSystem::PlayerQuests* QuestSystem::FindPlayer(PlayerId playerId) {
+    auto it = players_.find(playerId);
+    return it != players_.end() ? &it->second : nullptr;
+}
+
+const QuestSystem::ActiveQuest* QuestSystem::FindActive(const PlayerQuests& pq, uint32_t quest) {
+    for (const auto& aq : pq.active)
+        if (aq.quest == quest) return &aq;
+    return nullptr;
+}
+
+QuestSystem::ActiveObjective* QuestSystem::FindObjective(PlayerQuests& pq, uint32_t quest, ObjectiveId objectiveId) {
+    const Span<const PackObjective> objectives = pack_->Objectives(quest);
+    for (auto& obj : pq.objectives)
+        if (obj.quest == quest && obj.objective < objectives.size() && objectives[obj.objective].id == objectiveId)
+            return &obj;
+    return nullptr;
+}
+
+int32_t QuestSystem::ObjectiveTarget(const ActiveObjective& obj) const {
+    const Span<const PackObjective> objectives = pack_->Objectives(obj.quest);
+    return obj.objective < objectives.size() ? objectives[obj.objective].target : 0;
+}
+
+bool QuestSystem::GetQuest(QuestId id, QuestDefinition& out) const {
+    const uint32_t quest = DenseIndex(id);
+    if (quest == kNoQuest) return false;
+    pack_->Materialize(quest, out);
+    return true;
+}
+
+QuestProgress QuestSystem::Materialize(const PlayerQuests& pq, uint32_t quest) const {
     QuestProgress prog;
-    prog.questId = questId;
-    prog.state = QuestState::InProgress;
-    prog.objectives = def->objectives;
-    prog.startedAt = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count());
+    prog.questId = pack_->Quest(quest).id;
+    for (const PackObjective& obj : pack_->Objectives(quest)) {
+        prog.objectives.push_back(pack_->ToObjective(obj));
+        prog.objectives.back().current = 0;
+    }
+
+    if (const ActiveQuest* aq = FindActive(pq, quest)) {
+        prog.state = QuestState::InProgress;
+        prog.startedAt = aq->startedAt;
+        for (const auto& obj : pq.objectives)
+            if (obj.quest == quest && obj.objective < prog.objectives.size())
+                prog.objectives[obj.objective].current = obj.current;
+    } else if (TestFlag(pq, kCompletedPlane, quest)) {
+        prog.state = QuestState::Completed;
+        for (auto& obj : prog.objectives)
+            if (!obj.optional) obj.current = obj.target;
+    } else if (TestFlag(pq, kFailedPlane, quest)) {
+        prog.state = QuestState::Failed;
+    } else if (TestFlag(pq, kAbandonedPlane, quest)) {
+        prog.state = QuestState::Available;
+    }
+    return prog;
+}
 
-    playerProgress_[playerId][questId] = std::move(prog);
+QuestState QuestSystem::GetQuestState(PlayerId playerId, QuestId questId) const {
+    const uint32_t quest = DenseIndex(questId);
+    const PlayerQuests* pq = FindPlayer(playerId);
+    if (quest == kNoQuest || !pq) return QuestState::Locked;
+    if (TestFlag(*pq, kActivePlane, quest)) return QuestState::InProgress;
+    if (TestFlag(*pq, kCompletedPlane, quest)) return QuestState::Completed;
+    if (TestFlag(*pq, kFailedPlane, quest)) return QuestState::Failed;
+    if (TestFlag(*pq, kAbandonedPlane, quest)) return QuestState::Available;
+    return QuestState::Locked;
+}
+
+bool QuestSystem::GetPlayerProgress(PlayerId playerId, QuestId questId, QuestProgress& out) const {
+    const uint32_t quest = DenseIndex(questId);
+    const PlayerQuests* pq = FindPlayer(playerId);
+    if (quest == kNoQuest || !pq) return false;
+    QuestProgress prog = Materialize(*pq, quest);
+    if (prog.state == QuestState::Locked) return false;
+    out = std::move(prog);
+    return true;
+}
 
+bool QuestSystem::MeetsPrerequisite(const PlayerQuests* pq, uint32_t quest) const {
+    return TestBit(pack_->RootWords(), quest) || (pq && TestFlag(*pq, kUnlockedPlane, quest));
+}
+
+bool QuestSystem::StartQuest(PlayerId playerId, QuestId questId) {
+    const uint32_t quest = DenseIndex(questId);
+    if (quest == kNoQuest) return false;
+    if (!MeetsPrerequisite(FindPlayer(playerId), quest)) return false;
+
+    PlayerQuests& pq = players_[playerId];
+    if (TestFlag(pq, kActivePlane, quest) || TestFlag(pq, kAbandonedPlane, quest)) return false;
+
+    const uint32_t startedAt = static_cast<uint32_t>(NowSeconds());
+    BeginQuest(pq, quest, startedAt);
+    Persist(playerId, quest, QuestLogOp::State, QuestState::InProgress, 0, static_cast<int32_t>(startedAt));
+    RecordProgress(playerId, questId, QuestState::InProgress);
     if (onQuestEvent_)
         onQuestEvent_(playerId, questId, QuestState::InProgress);
     return true;
 }
 
+void QuestSystem::BeginQuest(PlayerQuests& pq, uint32_t quest, uint32_t startedAt) {
+    SetCompleted(pq, quest, false);
+    SetFlag(pq, kFailedPlane, quest, false);
+    SetFlag(pq, kActivePlane, quest, true);
+    pq.active.push_back(ActiveQuest{ quest, startedAt });
+    const Span<const PackObjective> objectives = pack_->Objectives(quest);
+    for (size_t i = 0; i < objectives.size(); ++i) {
+        ActiveObjective obj;
+        obj.target = MatchTarget(objectives[i]);
+        obj.quest = quest;
+        obj.current = objectives[i].initial;
+        obj.type = objectives[i].type;
+        obj.objective = static_cast<uint8_t>(i);
+        pq.objectives.push_back(obj);
+    }
+}
+
+void QuestSystem::Persist(PlayerId playerId, uint32_t quest, QuestLogOp op, QuestState state,
+                          ObjectiveId objectiveId, int32_t value) const {
+    if (!onPersist_) return;
+    QuestLogRecord rec;
+    rec.playerId = playerId;
+    rec.questId = pack_->Quest(quest).id;
+    rec.value = value;
+    rec.op = op;
+    rec.state = state;
+    rec.objectiveId = objectiveId;
+    onPersist_(rec);
+}
+
+void QuestSystem::PersistCounter(PlayerId playerId, const ActiveObjective& obj) const {
+    const ObjectiveId objectiveId = pack_->Objectives(obj.quest)[obj.objective].id;
+    Persist(playerId, obj.quest, QuestLogOp::Counter, QuestState::InProgress, objectiveId, obj.current);
+}
+
+void QuestSystem::RestorePlayer(PlayerId playerId, Span<const QuestLogRecord> records) {
+    PlayerQuests& pq = players_[playerId];
+    pq = PlayerQuests{};
+    for (const QuestLogRecord& rec : records) {
+        const uint32_t quest = DenseIndex(rec.questId);
+        if (quest == kNoQuest) continue;
+        if (rec.op == QuestLogOp::Counter) {
+            // Mapped by id through the current pack; ids it no longer has are dropped.
+            if (ActiveObjective* obj = FindObjective(pq, quest, rec.objectiveId))
+                obj->current = std::max(0, std::min(ObjectiveTarget(*obj), rec.value));
+            continue;
+        }
+        if (TestFlag(pq, kActivePlane, quest)) RetireQuest(pq, quest);
+        switch (rec.state) {
+        case QuestState::InProgress: BeginQuest(pq, quest, static_cast<uint32_t>(rec.value)); break;
+        case QuestState::Completed:  SetCompleted(pq, quest, true); break;
+        case QuestState::Failed:     SetFlag(pq, kFailedPlane, quest, true); break;
+        case QuestState::Available:  SetFlag(pq, kAbandonedPlane, quest, true); break;
+        case QuestState::Locked:     break;
+        }
+    }
+    CompactIfIdle(pq);
+}
+
+void QuestSystem::RetireQuest(PlayerQuests& pq, uint32_t quest) {
+    pq.active.erase(std::remove_if(pq.active.begin(), pq.active.end(),
+                                   [quest](const ActiveQuest& aq) { return aq.quest == quest; }),
+                    pq.active.end());
+    SetFlag(pq, kActivePlane, quest, false);
+    for (auto& obj : pq.objectives) {
+        if (obj.quest != quest) continue;
+        obj.quest = kRetired;
+        obj.target = kNoSymbol;
+        pq.hasRetired = true;
+    }
+}
+
+void QuestSystem::CompactIfIdle(PlayerQuests& pq) {
+    if (pq.dispatchDepth != 0 || !pq.hasRetired) return;
+    pq.objectives.erase(std::remove_if(pq.objectives.begin(), pq.objectives.end(),
+                                       [](const ActiveObjective& obj) { return obj.quest == kRetired; }),
+                        pq.objectives.end());
+    pq.hasRetired = false;
+}
+
 void QuestSystem::AbandonQuest(PlayerId playerId, QuestId questId) {
-    QuestProgress* prog = GetPlayerProgress(playerId, questId);
-    if (!prog || prog->state != QuestState::InProgress) return;
-    prog->state = QuestState::Available;
+    const uint32_t quest = DenseIndex(questId);
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (quest == kNoQuest || !pq || !TestFlag(*pq, kActivePlane, quest)) return;
+    RetireQuest(*pq, quest);
+    SetFlag(*pq, kAbandonedPlane, quest, true);
+    CompactIfIdle(*pq);
+    Persist(playerId, quest, QuestLogOp::State, QuestState::Available, 0, 0);
+    RecordProgress(playerId, questId, QuestState::Available);
     if (onQuestEvent_)
         onQuestEvent_(playerId, questId, QuestState::Available);
 }
 
+bool QuestSystem::IsQuestDone(const PlayerQuests& pq, uint32_t quest) const {
+    const Span<const PackObjective> objectives = pack_->Objectives(quest);
+    for (const auto& obj : pq.objectives) {
+        if (obj.quest != quest || obj.objective >= objectives.size()) continue;
+        const PackObjective& def = objectives[obj.objective];
+        if (!def.optional && obj.current < def.target) return false;
+    }
+    return true;
+}
+
+void QuestSystem::CompleteIfDone(PlayerId playerId, PlayerQuests& pq, uint32_t quest) {
+    if (!TestFlag(pq, kActivePlane, quest) || !IsQuestDone(pq, quest)) return;
+    RetireQuest(pq, quest);
+    SetCompleted(pq, quest, true);
+    Persist(playerId, quest, QuestLogOp::State, QuestState::Completed, 0, 0);
+    RecordProgress(playerId, pack_->Quest(quest).id, QuestState::Completed);
+    if (onQuestEvent_)
+        onQuestEvent_(playerId, pack_->Quest(quest).id, QuestState::Completed);
+}
+
+void QuestSystem::RecordProgress(PlayerId playerId, QuestId questId, QuestState state) {
+    if (analytics_)
+        analytics_->Record(analyticsProducer_, ProgressionKind::Quest, playerId, questId, static_cast<uint8_t>(state));
+}
+
 void QuestSystem::UpdateObjective(PlayerId playerId, QuestId questId, ObjectiveId objectiveId, int32_t delta) {
-    QuestProgress* prog = GetPlayerProgress(playerId, questId);
-    if (!prog || prog->state != QuestState::InProgress) return;
-
-    for (auto& obj : prog->objectives) {
-        if (obj.id == objectiveId) {
-            obj.current = std::max(0, std::min(obj.target, obj.current + delta));
-            CheckQuestCompletion(playerId, questId);
-            return;
-        }
+    const uint32_t quest = DenseIndex(questId);
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (quest == kNoQuest || !pq) return;
+    ActiveObjective* obj = FindObjective(*pq, quest, objectiveId);
+    if (!obj) return;
+    const int32_t current = std::max(0, std::min(ObjectiveTarget(*obj), obj->current + delta));
+    if (current != obj->current) {
+        obj->current = current;
+        PersistCounter(playerId, *obj);
     }
+    ++pq->dispatchDepth;
+    CompleteIfDone(playerId, *pq, quest);
+    --pq->dispatchDepth;
+    CompactIfIdle(*pq);
 }
 
 void QuestSystem::SetObjectiveProgress(PlayerId playerId, QuestId questId, ObjectiveId objectiveId, int32_t value) {
-    QuestProgress* prog = GetPlayerProgress(playerId, questId);
-    if (!prog || prog->state != QuestState::InProgress) return;
-
-    for (auto& obj : prog->objectives) {
-        if (obj.id == objectiveId) {
-            obj.current = std::max(0, std::min(obj.target, value));
-            CheckQuestCompletion(playerId, questId);
-            return;
-        }
+    const uint32_t quest = DenseIndex(questId);
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (quest == kNoQuest || !pq) return;
+    ActiveObjective* obj = FindObjective(*pq, quest, objectiveId);
+    if (!obj) return;
+    const int32_t current = std::max(0, std::min(ObjectiveTarget(*obj), value));
+    if (current != obj->current) {
+        obj->current = current;
+        PersistCounter(playerId, *obj);
     }
+    ++pq->dispatchDepth;
+    CompleteIfDone(playerId, *pq, quest);
+    --pq->dispatchDepth;
+    CompactIfIdle(*pq);
 }
 
-void QuestSystem::CheckQuestCompletion(PlayerId playerId, QuestId questId) {
-    QuestProgress* prog = GetPlayerProgress(playerId, questId);
-    if (!prog || prog->state != QuestState::InProgress) return;
-
-    bool allRequired = true;
-    for (const auto& obj : prog->objectives) {
-        if (obj.optional) continue;
-        if (obj.current < obj.target) {
-            allRequired = false;
-            break;
+template <typename Fn>
+void QuestSystem::AdvanceMatching(PlayerId playerId, PlayerQuests& pq, QuestObjectiveType type, SymbolId target, Fn&& fn) {
+    // Indices, not references: callbacks may append to pq.objectives.
+    ++pq.dispatchDepth;
+    for (size_t i = 0; i < pq.objectives.size(); ++i) {
+        ActiveObjective& obj = pq.objectives[i];
+        if (obj.type != type || obj.target != target || obj.quest == kRetired) continue;
+        const uint32_t quest = obj.quest;
+        const int32_t current = fn(obj.current, ObjectiveTarget(obj));
+        if (current != obj.current) {
+            obj.current = current;
+            PersistCounter(playerId, obj);
         }
+        CompleteIfDone(playerId, pq, quest);
     }
+    --pq.dispatchDepth;
+    CompactIfIdle(pq);
+}
 
-    if (allRequired) {
-        prog->state = QuestState::Completed;
-        prog->completedAt = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count());
-        if (onQuestEvent_)
-            onQuestEvent_(playerId, questId, QuestState::Completed);
-    }
+void QuestSystem::NotifyKill(PlayerId playerId, SymbolId targetType) {
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::Kill, targetType,
+                    [](int32_t current, int32_t goal) { return std::max(0, std::min(goal, current + 1)); });
 }
 
-void QuestSystem::NotifyKill(PlayerId playerId, const std::string& targetType) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::Kill && obj.targetId == targetType)
-                UpdateObjective(playerId, qid, obj.id, 1);
-    }
+void QuestSystem::NotifyKills(PlayerId playerId, Span<const SymbolId> targetTypes) {
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    for (SymbolId targetType : targetTypes)
+        AdvanceMatching(playerId, *pq, QuestObjectiveType::Kill, targetType,
+                        [](int32_t current, int32_t goal) { return std::max(0, std::min(goal, current + 1)); });
 }
 
-void QuestSystem::NotifyCollect(PlayerId playerId, const std::string& itemId) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::Collect && obj.targetId == itemId)
-                UpdateObjective(playerId, qid, obj.id, 1);
-    }
+void QuestSystem::NotifyCollect(PlayerId playerId, SymbolId itemId) {
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::Collect, itemId,
+                    [](int32_t current, int32_t goal) { return std::max(0, std::min(goal, current + 1)); });
 }
 
-void QuestSystem::NotifyReachLocation(PlayerId playerId, const std::string& locationId) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::ReachLocation && obj.targetId == locationId)
-                SetObjectiveProgress(playerId, qid, obj.id, 1);
-    }
+void QuestSystem::NotifyReachLocation(PlayerId playerId, SymbolId locationId) {
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::ReachLocation, locationId,
+                    [](int32_t, int32_t goal) { return std::max(0, std::min(goal, 1)); });
 }
 
-void QuestSystem::NotifyInteract(PlayerId playerId, const std::string& objectId) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::Interact && obj.targetId == objectId)
-                UpdateObjective(playerId, qid, obj.id, 1);
-    }
+void QuestSystem::NotifyInteract(PlayerId playerId, SymbolId objectId) {
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::Interact, objectId,
+                    [](int32_t current, int32_t goal) { return std::max(0, std::min(goal, current + 1)); });
 }
 
 void QuestSystem::NotifySurviveRounds(PlayerId playerId, int32_t rounds) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::SurviveRounds)
-                SetObjectiveProgress(playerId, qid, obj.id, rounds);
-    }
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::SurviveRounds, kAnyTarget,
+                    [rounds](int32_t, int32_t goal) { return std::max(0, std::min(goal, rounds)); });
 }
 
 void QuestSystem::NotifyWinMatch(PlayerId playerId, GameMode /*mode*/) {
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return;
-    for (auto& [qid, prog] : pit->second) {
-        if (prog.state != QuestState::InProgress) continue;
-        for (const auto& obj : prog.objectives)
-            if (obj.type == QuestObjectiveType::WinMatches)
-                UpdateObjective(playerId, qid, obj.id, 1);
-    }
+    PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return;
+    AdvanceMatching(playerId, *pq, QuestObjectiveType::WinMatches, kAnyTarget,
+                    [](int32_t current, int32_t goal) { return std::max(0, std::min(goal, current + 1)); });
 }
 
 std::vector<QuestId> QuestSystem::GetAvailableQuests(PlayerId playerId) const {
     std::vector<QuestId> out;
-    for (const auto& [qid, def] : quests_) {
-        const QuestProgress* prog = GetPlayerProgress(playerId, qid);
-        if (prog && prog->state == QuestState::Completed) continue;
-        if (prog && prog->state == QuestState::InProgress) continue;
-        if (MeetsPrerequisite(playerId, qid))
-            out.push_back(qid);
+    const PlayerQuests* pq = FindPlayer(playerId);
+    // Available = (root | unlocked) & ~completed & ~active, a word at a time.
+    // Blocks are sorted, so they are merged with the root words in one pass.
+    const Span<const uint64_t> roots = pack_->RootWords();
+    size_t next = 0;  // the player's next flag block
+    for (size_t w = 0; w < roots.size(); ++w) {
+        uint64_t bits = roots[w];
+        if (pq && next < pq->flagBlocks.size() && pq->flagBlocks[next] == w) {
+            const uint64_t* planes = &pq->flags[next++ * kPlaneCount];
+            bits = (bits | planes[kUnlockedPlane]) & ~(planes[kCompletedPlane] | planes[kActivePlane]);
+        }
+        for (; bits != 0; bits &= bits - 1)
+            out.push_back(pack_->Quest(static_cast<uint32_t>(w * 64) + LowestSetBit(bits)).id);
     }
     return out;
 }
 
 std::vector<QuestProgress> QuestSystem::GetActiveQuests(PlayerId playerId) const {
     std::vector<QuestProgress> out;
-    auto pit = playerProgress_.find(playerId);
-    if (pit == playerProgress_.end()) return out;
-    for (const auto& [qid, prog] : pit->second)
-        if (prog.state == QuestState::InProgress)
-            out.push_back(prog);
+    const PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return out;
+    out.reserve(pq->active.size());
+    for (const auto& aq : pq->active)
+        out.push_back(Materialize(*pq, aq.quest));
     return out;
 }
 
+size_t QuestSystem::PlayerStateBytes(PlayerId playerId) const {
+    const PlayerQuests* pq = FindPlayer(playerId);
+    if (!pq) return 0;
+    return pq->flagBlocks.capacity() * sizeof(uint32_t) + pq->flags.capacity() * sizeof(uint64_t) +
+           pq->active.capacity() * sizeof(ActiveQuest) + pq->objectives.capacity() * sizeof(ActiveObjective);
+}
+
 } // namespace game
@@ -1,46 +1,228 @@
 #pragma once
 
 #include "GameTypes.h"
+#include "QuestPack.h"
+#include "Span.h"
+#include <string>
 #include <unordered_map>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace game {
 
+class ProgressionAnalytics;
+
+// One persistent quest mutation. A player's state is the in-order fold of
+// their records: State records set a quest's state (InProgress restarts it
+// with fresh counters and value = startedAt, Unix seconds stored as their
+// uint32_t bit pattern), Counter records set objective `objectiveId` of an
+// in-progress quest to value. Objectives are named by id, not position, so
+// a stored log stays valid across packs that reorder them.
+enum class QuestLogOp : uint8_t { State, Counter };
+
+struct QuestLogRecord {
+    PlayerId playerId = 0;
+    QuestId questId = 0;
+    int32_t value = 0;
+    ObjectiveId objectiveId = 0;  // Counter records only
+    QuestLogOp op = QuestLogOp::State;
+    QuestState state = QuestState::Locked;
+    uint16_t reserved = 0;
+};
+static_assert(sizeof(QuestLogRecord) == 20, "QuestLogRecord is written to disk as-is");
+
+// ---------------------------------------------------------------------------
+// Quest registry and per-player quest progress.
+//
+// Definitions live in a QuestPack (dense, registration order): either one
+// mapped from a compiled pack file or the system's own editable pack that
+// RegisterQuest adds to. They are never copied per player. A player's state
+// is a few flag planes over the dense quest index (kept only for the 64-quest
+// blocks the player has touched, so it follows their history rather than
+// the catalog size) plus one 8-byte record per in-progress quest and one
+// 16-byte counter per in-progress objective. The
+// counters double as the event index: each carries its objective's (type,
+// target), so a Notify* call compares integers over the player's live
+// objectives only.
+//
+// Prerequisites are compiled into a graph (each quest lists the quests it
+// unlocks). A player's unlocked plane mirrors "prerequisite completed" and
+// is updated along those edges whenever a completed flag changes, so
+// availability is a word-wise bit expression and a completion costs
+// O(out-degree).
+// ---------------------------------------------------------------------------
 class QuestSystem {
 public:
     using QuestEventCallback = std::function<void(PlayerId, QuestId, QuestState)>;
+    using PersistCallback = std::function<void(const QuestLogRecord&)>;
 
-    QuestSystem() = default;
+    QuestSystem();
 
-    void RegisterQuest(QuestDefinition def);
-    const QuestDefinition* GetQuest(QuestId id) const;
-    QuestProgress* GetPlayerProgress(PlayerId playerId, QuestId questId);
-    const QuestProgress* GetPlayerProgress(PlayerId playerId, QuestId questId) const;
+    // Ignored if the id is 0, the objectives don't fit or the prerequisite
+    // chain would lead back to the quest itself. Re-registering an id
+    // replaces its definition and moves player state onto it as UsePack
+    // does (so, once players exist, not from a callback). After UsePack, the
+    // first registration copies the pack's tables.
+    void RegisterQuest(const QuestDefinition& def);
+    // Fills out with a copy of the definition; false if unregistered.
+    bool GetQuest(QuestId id, QuestDefinition& out) const;
+    size_t QuestCount() const { return pack_->QuestCount(); }
+
+    // Replaces every definition with the pack's (QuestPack::Open). Players
+    // keep their state by quest id, and in-progress counters by objective
+    // id (clamped to the new targets); quests missing from the pack drop
+    // out of player state, and unlocked flags follow the new prerequisites.
+    // Stored records name objectives by id, so RestorePlayer maps a player
+    // who was offline during the swap onto the new layout; quests whose
+    // layout changed are re-persisted for the players held here (InProgress
+    // plus Counter records), so dropped or clamped counters stay that way.
+    // Call between ticks, not from a callback. Text- and reward-only edits
+    // touch no player.
+    void UsePack(std::shared_ptr<const QuestPack> pack);
+    const QuestPack& Pack() const { return *pack_; }
+
+    // Fills out with a copy of the player's progress on the quest; false if
+    // the player has no state for it (Locked). Only in-progress quests keep
+    // counters and a start time: completed quests report their required
+    // objectives at target, abandoned and failed ones report zeros.
+    bool GetPlayerProgress(PlayerId playerId, QuestId questId, QuestProgress& out) const;
+    QuestState GetQuestState(PlayerId playerId, QuestId questId) const;
 
     bool StartQuest(PlayerId playerId, QuestId questId);
     void AbandonQuest(PlayerId playerId, QuestId questId);
     void UpdateObjective(PlayerId playerId, QuestId questId, ObjectiveId objectiveId, int32_t delta);
     void SetObjectiveProgress(PlayerId playerId, QuestId questId, ObjectiveId objectiveId, int32_t value);
 
-    void NotifyKill(PlayerId playerId, const std::string& targetType);
-    void NotifyCollect(PlayerId playerId, const std::string& itemId);
-    void NotifyReachLocation(PlayerId playerId, const std::string& locationId);
-    void NotifyInteract(PlayerId playerId, const std::string& objectId);
+    // Targets match by symbol id; the string forms hash their argument.
+    void NotifyKill(PlayerId playerId, SymbolId targetType);
+    void NotifyKill(PlayerId playerId, std::string_view targetType) { NotifyKill(playerId, SymbolHash(targetType)); }
+    void NotifyKills(PlayerId playerId, Span<const SymbolId> targetTypes);
+    void NotifyCollect(PlayerId playerId, SymbolId itemId);
+    void NotifyCollect(PlayerId playerId, std::string_view itemId) { NotifyCollect(playerId, SymbolHash(itemId)); }
+    void NotifyReachLocation(PlayerId playerId, SymbolId locationId);
+    void NotifyReachLocation(PlayerId playerId, std::string_view locationId) {
+        NotifyReachLocation(playerId, SymbolHash(locationId));
+    }
+    void NotifyInteract(PlayerId playerId, SymbolId objectId);
+    void NotifyInteract(PlayerId playerId, std::string_view objectId) { NotifyInteract(playerId, SymbolHash(objectId)); }
     void NotifySurviveRounds(PlayerId playerId, int32_t rounds);
     void NotifyWinMatch(PlayerId playerId, GameMode mode);
 
     std::vector<QuestId> GetAvailableQuests(PlayerId playerId) const;
     std::vector<QuestProgress> GetActiveQuests(PlayerId playerId) const;
 
+    // Heap bytes held for one player's quest state (excluding the player
+    // table entry itself); for capacity planning and benchmarks.
+    size_t PlayerStateBytes(PlayerId playerId) const;
+
     void SetEventCallback(QuestEventCallback cb) { onQuestEvent_ = std::move(cb); }
+    // Start, abandon and completion events also go to analytics as
+    // `producer` (the ring this system's thread owns); nullptr detaches.
+    void SetAnalytics(ProgressionAnalytics* analytics, size_t producer) {
+        analytics_ = analytics;
+        analyticsProducer_ = producer;
+    }
+
+    // Persistence: the callback receives every state and counter mutation
+    // as a log record (before the matching event callback). RestorePlayer
+    // replaces a player's state with the fold of records (no callbacks;
+    // records for unregistered quests or objectives are skipped, counters
+    // are clamped to the current targets); RemovePlayer drops it.
+    void SetPersistCallback(PersistCallback cb) { onPersist_ = std::move(cb); }
+    void RestorePlayer(PlayerId playerId, Span<const QuestLogRecord> records);
+    void RemovePlayer(PlayerId playerId) { players_.erase(playerId); }
 
 private:
-    void CheckQuestCompletion(PlayerId playerId, QuestId questId);
-    bool MeetsPrerequisite(PlayerId playerId, QuestId questId) const;
+    enum FlagPlane : uint32_t {
+        kCompletedPlane,
+        kFailedPlane,
+        kAbandonedPlane,  // QuestState::Available
+        kActivePlane,     // mirrors PlayerQuests::active
+        kUnlockedPlane,   // prerequisite completed (quests without one use the pack's root bits)
+        kPlaneCount
+    };
+
+    struct ActiveQuest {
+        uint32_t quest = 0;      // dense quest index
+        uint32_t startedAt = 0;  // Unix seconds
+    };
+    // One in-progress objective, in start order. Entries of a finished or
+    // abandoned quest are retired in place (quest = kRetired, which no event
+    // matches) and compacted once no event is being dispatched, so an event
+    // callback may start, abandon or complete quests mid-dispatch.
+    struct ActiveObjective {
+        SymbolId target = kNoSymbol;  // kAnyTarget for target-less types
+        uint32_t quest = 0;           // dense quest index, or kRetired
+        int32_t current = 0;
+        QuestObjectiveType type = QuestObjectiveType::Kill;
+        uint8_t objective = 0;        // index into the definition's objectives
+        uint16_t reserved = 0;
+    };
+    static_assert(sizeof(ActiveObjective) == 16, "ActiveObjective should stay 16 bytes");
+    struct PlayerQuests {
+        // Flag planes over 64-quest blocks, stored only for blocks the player
+        // has set a flag in: flags[i * kPlaneCount + p] is plane p of block
+        // flagBlocks[i] (ascending).
+        std::vector<uint32_t> flagBlocks;
+        std::vector<uint64_t> flags;
+        std::vector<ActiveQuest> active;
+        std::vector<ActiveObjective> objectives;
+        uint16_t dispatchDepth = 0;   // nested event dispatches in flight
+        bool hasRetired = false;
+    };
+
+    static constexpr SymbolId kAnyTarget = kNoSymbol;  // SurviveRounds / WinMatches ignore the target
+    static constexpr uint32_t kRetired = UINT32_MAX;
+    static constexpr uint32_t kNoQuest = QuestPack::kNoQuest;
+
+    static SymbolId MatchTarget(const PackObjective& obj);
+    static const uint64_t* FlagBlock(const PlayerQuests& pq, uint32_t block);  // nullptr if not stored
+    static uint64_t* FlagBlock(PlayerQuests& pq, uint32_t block);
+    static bool TestFlag(const PlayerQuests& pq, FlagPlane plane, uint32_t quest);
+    static void SetFlag(PlayerQuests& pq, FlagPlane plane, uint32_t quest, bool value);
+    uint32_t DenseIndex(QuestId id) const { return pack_->Find(id); }  // kNoQuest if unregistered
+    const PlayerQuests* FindPlayer(PlayerId playerId) const;
+    PlayerQuests* FindPlayer(PlayerId playerId);
+    static const ActiveQuest* FindActive(const PlayerQuests& pq, uint32_t quest);
+    ActiveObjective* FindObjective(PlayerQuests& pq, uint32_t quest, ObjectiveId objectiveId);
+    int32_t ObjectiveTarget(const ActiveObjective& obj) const;
+    QuestProgress Materialize(const PlayerQuests& pq, uint32_t quest) const;
+
+    void BeginQuest(PlayerQuests& pq, uint32_t quest, uint32_t startedAt);
+    void Persist(PlayerId playerId, uint32_t quest, QuestLogOp op, QuestState state, ObjectiveId objectiveId,
+                 int32_t value) const;
+    void PersistCounter(PlayerId playerId, const ActiveObjective& obj) const;
+    bool IsQuestDone(const PlayerQuests& pq, uint32_t quest) const;
+    void RetireQuest(PlayerQuests& pq, uint32_t quest);
+    void CompactIfIdle(PlayerQuests& pq);
+    void CompleteIfDone(PlayerId playerId, PlayerQuests& pq, uint32_t quest);
+    // Sets current = fn(current, target) on each live objective of the given
+    // type and target (including ones started by callbacks during the
+    // dispatch), completing quests as they finish.
+    template <typename Fn>
+    void AdvanceMatching(PlayerId playerId, PlayerQuests& pq, QuestObjectiveType type, SymbolId target, Fn&& fn);
+    bool MeetsPrerequisite(const PlayerQuests* pq, uint32_t quest) const;
+
+    // Recomputes quest's unlocked flag for every player (registration only).
+    void RefreshUnlocked(uint32_t quest);
+    // Moves player state from old's dense indices and objective layouts to
+    // pack_'s (UsePack).
+    void RebindPlayers(const QuestPack& old);
+    void RebindPlayer(PlayerId playerId, PlayerQuests& pq, const QuestPack& old, const std::vector<uint32_t>& remap,
+                      const std::vector<uint8_t>& layoutChanged);
+    // Sets the completed flag and propagates it to the unlocked flags of
+    // the quest's dependents.
+    void SetCompleted(PlayerQuests& pq, uint32_t quest, bool value);
+    void RecordProgress(PlayerId playerId, QuestId questId, QuestState state);
 
-    std::unordered_map<QuestId, QuestDefinition> quests_;
-    std::unordered_map<PlayerId, std::unordered_map<QuestId, QuestProgress>> playerProgress_;
+    std::shared_ptr<const QuestPack> pack_;
+    QuestPack* editable_ = nullptr;  // pack_, when it is this system's own editable copy
+    std::unordered_map<PlayerId, PlayerQuests> players_;
     QuestEventCallback onQuestEvent_;
+    PersistCallback onPersist_;
+    ProgressionAnalytics* analytics_ = nullptr;
+    size_t analyticsProducer_ = 0;
 };
 
 } // namespace game
@@ -0,0 +1,258 @@
+/**
+ * Virtual Sim — Quest system scale benchmark
+ * Registers a quest catalog (the 50 quests from QuestData.cpp, or a synthetic
+ * set of 10k in prerequisite chains), starts quests for N simulated players
+ * and fires a mixed storm of Notify* events at random players; completed
+ * quests are replaced from the event callback, as a client would. Reports,
+ * as JSON per catalog: setup time, events per second, per-event latency
+ * percentiles, quest state bytes per player, heap allocations (setup and per
+ * event) and the process peak resident memory so far.
+ *
+ * Usage: quest_bench [--players N] [--events N] [--active N] [--catalog 50|10k|all]
+ */
+
+#include "BenchSupport.h"
+#include "Quest.h"
+#include "QuestData.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace game;
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    const char* catalog = "";
+    size_t quests = 0;
+    int players = 0;
+    int events = 0;
+    double registerMs = 0.0;
+    double startMs = 0.0;
+    double activeQuestsPerPlayer = 0.0;
+    double eventsPerSec = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double p999Ns = 0.0;
+    double stateBytesPerPlayer = 0.0;
+    double setupAllocsPerPlayer = 0.0;
+    double allocsPerEvent = 0.0;
+    double allocBytesPerEvent = 0.0;
+    uint64_t completions = 0;
+    uint64_t peakRssKb = 0;
+};
+
+// Synthetic quests share a few targets with the 50-quest catalog. The storm
+// draws from the registered pack's objective targets plus a few tags no
+// objective matches.
+static const char* const kSharedTags[] = { "enemy", "supply_crate", "outpost", "relay" };
+static const char* const kMissTags[] = { "zombie", "crate_empty", "npc" };
+static constexpr int kSyntheticTags = 64;
+static constexpr int kSyntheticQuests = 10000;
+static constexpr int kChainLength = 5;  // synthetic quests come in chains of 5
+
+static void RegisterSyntheticQuests(QuestSystem& quests) {
+    static const QuestObjectiveType kTypes[] = {
+        QuestObjectiveType::Kill, QuestObjectiveType::Collect, QuestObjectiveType::Interact,
+        QuestObjectiveType::ReachLocation, QuestObjectiveType::SurviveRounds, QuestObjectiveType::WinMatches,
+    };
+    std::mt19937 rng(7);
+    for (int i = 0; i < kSyntheticQuests; ++i) {
+        QuestDefinition def;
+        def.id = static_cast<QuestId>(1000 + i);
+        def.category = i % 2 ? QuestCategory::OuterSpace : QuestCategory::Land;
+        def.title = "Synthetic " + std::to_string(i);
+        def.description = "Generated quest for the scale benchmark.";
+        def.rewardPoints = 100 + static_cast<int32_t>(rng() % 500);
+        def.prerequisiteQuestId = i % kChainLength == 0 ? 0 : def.id - 1;
+        const int objectives = 1 + static_cast<int>(rng() % 3);
+        for (int o = 0; o < objectives; ++o) {
+            QuestObjective obj;
+            obj.id = static_cast<ObjectiveId>(o + 1);
+            obj.type = kTypes[rng() % 6];
+            obj.target = 3 + static_cast<int32_t>(rng() % 18);
+            if (obj.type == QuestObjectiveType::ReachLocation) obj.target = 1;
+            if (obj.type != QuestObjectiveType::SurviveRounds && obj.type != QuestObjectiveType::WinMatches)
+                obj.targetId = rng() % 4 == 0 ? kSharedTags[rng() % 4]
+                                              : "tag_" + std::to_string(rng() % kSyntheticTags);
+            obj.optional = o > 0 && rng() % 5 == 0;
+            def.objectives.push_back(std::move(obj));
+        }
+        quests.RegisterQuest(def);
+    }
+}
+
+// One Notify* call; kinds roughly follow a match's event mix.
+struct StormEvent {
+    PlayerId player = 0;
+    uint8_t kind = 0;  // 0 kill, 1 collect, 2 interact, 3 reach, 4 survive, 5 win
+    int32_t value = 0;
+    SymbolId target = kNoSymbol;
+};
+
+static void Fire(QuestSystem& quests, const StormEvent& ev) {
+    switch (ev.kind) {
+    case 0: quests.NotifyKill(ev.player, ev.target); break;
+    case 1: quests.NotifyCollect(ev.player, ev.target); break;
+    case 2: quests.NotifyInteract(ev.player, ev.target); break;
+    case 3: quests.NotifyReachLocation(ev.player, ev.target); break;
+    case 4: quests.NotifySurviveRounds(ev.player, ev.value); break;
+    default: quests.NotifyWinMatch(ev.player, GameMode::TeamDeathmatch); break;
+    }
+}
+
+// Every distinct objective target in the pack (registration order), then the
+// miss tags.
+static std::vector<SymbolId> StormTags(const QuestPack& pack) {
+    std::vector<SymbolId> tags;
+    for (uint32_t q = 0; q < pack.QuestCount(); ++q)
+        for (const PackObjective& obj : pack.Objectives(q))
+            if (obj.targetId.length != 0 && std::find(tags.begin(), tags.end(), obj.targetSymbol) == tags.end())
+                tags.push_back(obj.targetSymbol);
+    for (const char* tag : kMissTags) tags.push_back(SymbolHash(tag));
+    return tags;
+}
+
+static std::vector<StormEvent> MakeStorm(int count, int players, const std::vector<SymbolId>& tags,
+                                         std::mt19937& rng) {
+
+    std::vector<StormEvent> storm(static_cast<size_t>(count));
+    std::uniform_int_distribution<PlayerId> player(1, static_cast<PlayerId>(players));
+    for (StormEvent& ev : storm) {
+        ev.player = player(rng);
+        const uint32_t roll = rng() % 100;
+        ev.kind = roll < 45 ? 0 : roll < 65 ? 1 : roll < 78 ? 2 : roll < 88 ? 3 : roll < 95 ? 4 : 5;
+        ev.target = tags[rng() % tags.size()];
+        ev.value = 1 + static_cast<int32_t>(rng() % 12);
+    }
+    return storm;
+}
+
+static double Percentile(std::vector<uint32_t>& samples, double q) {
+    if (samples.empty()) return 0.0;
+    const size_t k = std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+    return samples[k];
+}
+
+static BenchResult RunCatalog(const char* name, bool synthetic, int players, int events, int active,
+                              std::mt19937& rng) {
+    BenchResult r;
+    r.catalog = name;
+    r.players = players;
+    r.events = events;
+
+    QuestSystem quests;
+    auto t0 = Clock::now();
+    if (synthetic)
+        RegisterSyntheticQuests(quests);
+    else
+        RegisterAllQuests(quests);
+    r.registerMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    r.quests = quests.QuestCount();
+    const std::vector<SymbolId> tags = StormTags(quests.Pack());
+
+    // Quests a player can take without history: the chain heads.
+    std::vector<QuestId> roots = quests.GetAvailableQuests(0);
+    uint64_t completions = 0;
+    quests.SetEventCallback([&](PlayerId playerId, QuestId, QuestState state) {
+        if (state != QuestState::Completed) return;
+        ++completions;
+        quests.StartQuest(playerId, roots[rng() % roots.size()]);
+    });
+
+    const uint64_t setupAllocs0 = g_allocCount.load();
+    t0 = Clock::now();
+    uint64_t started = 0;
+    for (PlayerId p = 1; p <= static_cast<PlayerId>(players); ++p)
+        for (int a = 0; a < active; ++a)
+            started += quests.StartQuest(p, roots[rng() % roots.size()]) ? 1 : 0;
+    r.startMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    r.setupAllocsPerPlayer = static_cast<double>(g_allocCount.load() - setupAllocs0) / players;
+    r.activeQuestsPerPlayer = static_cast<double>(started) / players;
+
+    // Throughput pass, then a timed pass over a fresh storm for latency.
+    std::vector<StormEvent> storm = MakeStorm(events, players, tags, rng);
+    const uint64_t allocCount0 = g_allocCount.load();
+    const uint64_t allocBytes0 = g_allocBytes.load();
+    t0 = Clock::now();
+    for (const StormEvent& ev : storm) Fire(quests, ev);
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    r.eventsPerSec = sec > 0.0 ? events / sec : 0.0;
+    r.allocsPerEvent = static_cast<double>(g_allocCount.load() - allocCount0) / events;
+    r.allocBytesPerEvent = static_cast<double>(g_allocBytes.load() - allocBytes0) / events;
+
+    storm = MakeStorm(std::min(events, 1000000), players, tags, rng);
+    std::vector<uint32_t> latencies(storm.size());
+    for (size_t i = 0; i < storm.size(); ++i) {
+        auto start = Clock::now();
+        Fire(quests, storm[i]);
+        latencies[i] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start).count());
+    }
+    r.p50Ns = Percentile(latencies, 0.50);
+    r.p99Ns = Percentile(latencies, 0.99);
+    r.p999Ns = Percentile(latencies, 0.999);
+
+    double stateBytes = 0.0;
+    for (PlayerId p = 1; p <= static_cast<PlayerId>(players); ++p)
+        stateBytes += static_cast<double>(quests.PlayerStateBytes(p));
+    r.stateBytesPerPlayer = stateBytes / players;
+    r.completions = completions;
+    r.peakRssKb = PeakRssKb();
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int players = 1000000;
+    int events = 5000000;
+    int active = 8;
+    const char* catalog = "all";
+    static const char kUsage[] = "usage: quest_bench [--players N] [--events N] [--active N] [--catalog 50|10k|all]\n";
+    for (int i = 1; i < argc; i += 2) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            std::printf("%s", kUsage);
+            return 0;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value && std::strcmp(argv[i], "--players") == 0) players = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--events") == 0) events = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--active") == 0) active = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--catalog") == 0 &&
+                 (std::strcmp(value, "50") == 0 || std::strcmp(value, "10k") == 0 || std::strcmp(value, "all") == 0))
+            catalog = value;
+        else {
+            std::fprintf(stderr, "quest_bench: bad argument '%s'\n%s", argv[i], kUsage);
+            return 2;
+        }
+    }
+    players = std::max(players, 1);
+    events = std::max(events, 1);
+
+    std::mt19937 rng(42);
+    std::vector<BenchResult> results;
+    // Catalogs run one at a time (each QuestSystem is freed before the
+    // next), so each peak RSS covers the largest run so far.
+    if (std::strcmp(catalog, "10k") != 0) results.push_back(RunCatalog("50", false, players, events, active, rng));
+    if (std::strcmp(catalog, "50") != 0) results.push_back(RunCatalog("10k", true, players, events, active, rng));
+
+    std::printf("{\"players\":%d,\"events\":%d,\"startsPerPlayer\":%d,\"results\":[", players, events, active);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::printf("%s\n  {\"catalog\":\"%s\",\"quests\":%zu,\"registerMs\":%.1f,\"startMs\":%.1f,"
+                    "\"activeQuestsPerPlayer\":%.2f,\"eventsPerSec\":%.0f,\"p50Ns\":%.0f,\"p99Ns\":%.0f,"
+                    "\"p999Ns\":%.0f,\"stateBytesPerPlayer\":%.1f,\"setupAllocsPerPlayer\":%.2f,"
+                    "\"allocsPerEvent\":%.3f,\"allocBytesPerEvent\":%.1f,\"completions\":%llu,\"peakRssKb\":%llu}",
+                    i ? "," : "", r.catalog, r.quests, r.registerMs, r.startMs, r.activeQuestsPerPlayer,
+                    r.eventsPerSec, r.p50Ns, r.p99Ns, r.p999Ns, r.stateBytesPerPlayer, r.setupAllocsPerPlayer,
+                    r.allocsPerEvent, r.allocBytesPerEvent, static_cast<unsigned long long>(r.completions),
+                    static_cast<unsigned long long>(r.peakRssKb));
+    }
+    std::printf("\n]}\n");
+    return 0;
+}
@@ -0,0 +1,339 @@
+#include "QuestPack.h"
+#include "Symbol.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace game {
+
+namespace {
+
+constexpr uint64_t kTableAlign = 8;
+
+uint64_t AlignUp(uint64_t offset) { return (offset + kTableAlign - 1) & ~(kTableAlign - 1); }
+
+uint32_t RootWordCount(uint32_t questCount) { return (questCount + 63) / 64; }
+
+bool TestBit(Span<const uint64_t> bits, uint32_t index) {
+    return index / 64 < bits.size() && ((bits[index / 64] >> (index % 64)) & 1u);
+}
+
+template <typename T>
+bool TableAt(const MappedFile& file, uint64_t offset, uint64_t count, Span<const T>& out) {
+    if (offset % kTableAlign != 0 || offset > file.Size() || count > (file.Size() - offset) / sizeof(T))
+        return false;
+    out = Span<const T>(reinterpret_cast<const T*>(file.Data() + offset), static_cast<size_t>(count));
+    return true;
+}
+
+bool InTable(PackString s, size_t stringBytes) {
+    return s.offset <= stringBytes && s.length <= stringBytes - s.offset;
+}
+
+template <typename T>
+bool WriteTable(std::FILE* file, uint64_t offset, const T* data, size_t count) {
+    static const char kZeros[kTableAlign] = {};
+    const long pos = std::ftell(file);
+    if (pos < 0 || static_cast<uint64_t>(pos) > offset) return false;
+    const size_t pad = static_cast<size_t>(offset - static_cast<uint64_t>(pos));
+    if (pad != 0 && std::fwrite(kZeros, 1, pad, file) != pad) return false;
+    return count == 0 || std::fwrite(data, sizeof(T), count, file) == count;
+}
+
+} // namespace
+
+std::shared_ptr<const QuestPack> QuestPack::Open(const std::string& path) {
+    MappedFile file;
+    if (!file.Open(path)) return nullptr;
+    auto pack = std::make_shared<QuestPack>();
+    if (!pack->Map(std::move(file))) return nullptr;
+    return pack;
+}
+
+bool QuestPack::Map(MappedFile file) {
+    QuestPackHeader header;
+    if (file.Size() < sizeof(header)) return false;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, QuestPackHeader{}.magic, sizeof(header.magic)) != 0 ||
+        header.fileSize != file.Size())
+        return false;
+    Span<const PackQuest> quests;
+    Span<const PackObjective> objectives;
+    Span<const PackQuestIndex> index;
+    Span<const uint32_t> edges;
+    Span<const uint64_t> roots;
+    Span<const char> strings;
+    if (!TableAt(file, header.questsOffset, header.questCount, quests) ||
+        !TableAt(file, header.objectivesOffset, header.objectiveCount, objectives) ||
+        !TableAt(file, header.indexOffset, header.questCount, index) ||
+        !TableAt(file, header.edgesOffset, header.edgeCount, edges) ||
+        !TableAt(file, header.rootsOffset, RootWordCount(header.questCount), roots) ||
+        !TableAt(file, header.stringsOffset, header.stringBytes, strings))
+        return false;
+
+    // Everything the accessors index is range-checked once here.
+    for (uint32_t q = 0; q < quests.size(); ++q) {
+        const PackQuest& rec = quests[q];
+        if (rec.firstObjective > objectives.size() || rec.objectiveCount > objectives.size() - rec.firstObjective ||
+            rec.firstDependent > edges.size() || rec.dependentCount > edges.size() - rec.firstDependent ||
+            !InTable(rec.title, strings.size()) || !InTable(rec.description, strings.size()) ||
+            TestBit(roots, q) != (rec.prerequisite == 0))
+            return false;
+        for (uint32_t e = rec.firstDependent; e < rec.firstDependent + rec.dependentCount; ++e)
+            if (edges[e] >= quests.size() || quests[edges[e]].prerequisite != rec.id) return false;
+        const PackQuestIndex& entry = index[q];
+        if (entry.quest >= quests.size() || quests[entry.quest].id != entry.id || entry.id == 0 ||
+            (q > 0 && index[q - 1].id >= entry.id))
+            return false;
+    }
+    if (quests.size() % 64 != 0 && !roots.empty() && (roots[roots.size() - 1] >> (quests.size() % 64)) != 0)
+        return false;
+    for (const PackObjective& obj : objectives)
+        if (!InTable(obj.targetId, strings.size())) return false;
+
+    quests_ = quests;
+    objectives_ = objectives;
+    index_ = index;
+    edges_ = edges;
+    roots_ = roots;
+    strings_ = strings;
+    file_ = std::move(file);
+    editable_ = false;
+    return true;
+}
+
+std::shared_ptr<QuestPack> QuestPack::Clone() const {
+    auto copy = std::make_shared<QuestPack>();
+    copy->ownQuests_.assign(quests_.begin(), quests_.end());
+    copy->ownObjectives_.assign(objectives_.begin(), objectives_.end());
+    copy->ownIndex_.assign(index_.begin(), index_.end());
+    copy->ownRoots_.assign(roots_.begin(), roots_.end());
+    copy->ownStrings_.assign(strings_.begin(), strings_.end());
+    copy->ownDependents_.resize(quests_.size());
+    for (uint32_t q = 0; q < quests_.size(); ++q) {
+        Span<const uint32_t> dependents = Dependents(q);
+        copy->ownDependents_[q].assign(dependents.begin(), dependents.end());
+        const QuestId prereq = quests_[q].prerequisite;
+        if (prereq != 0 && Find(prereq) == kNoQuest)
+            copy->pendingDependents_[prereq].push_back(q);
+    }
+    copy->Refresh();
+    return copy;
+}
+
+void QuestPack::Refresh() {
+    quests_ = ownQuests_;
+    objectives_ = ownObjectives_;
+    index_ = ownIndex_;
+    roots_ = ownRoots_;
+    strings_ = Span<const char>(ownStrings_.data(), ownStrings_.size());
+}
+
+Span<const uint32_t> QuestPack::Dependents(uint32_t quest) const {
+    if (editable_) return ownDependents_[quest];
+    return Span<const uint32_t>(edges_.data() + quests_[quest].firstDependent, quests_[quest].dependentCount);
+}
+
+uint32_t QuestPack::Find(QuestId id) const {
+    auto it = std::lower_bound(index_.begin(), index_.end(), id,
+                               [](const PackQuestIndex& entry, QuestId key) { return entry.id < key; });
+    return it != index_.end() && it->id == id ? it->quest : kNoQuest;
+}
+
+PackString QuestPack::AddString(std::string_view text) {
+    PackString s;
+    s.offset = static_cast<uint32_t>(ownStrings_.size());
+    s.length = static_cast<uint32_t>(text.size());
+    ownStrings_.append(text);
+    return s;
+}
+
+bool QuestPack::CreatesCycle(QuestId id, QuestId prerequisite) const {
+    // Chains are acyclic, so this walk ends at a root, at an unknown id or
+    // back at id; the step bound covers packs written by something else.
+    uint32_t steps = 0;
+    for (QuestId cur = prerequisite; cur != 0; ++steps) {
+        if (cur == id || steps > quests_.size()) return true;
+        const uint32_t quest = Find(cur);
+        if (quest == kNoQuest) return false;
+        cur = quests_[quest].prerequisite;
+    }
+    return false;
+}
+
+void QuestPack::LinkPrerequisite(uint32_t quest) {
+    const QuestId prereqId = ownQuests_[quest].prerequisite;
+    ownRoots_.resize(RootWordCount(static_cast<uint32_t>(ownQuests_.size())), 0);
+    const uint64_t bit = uint64_t{ 1 } << (quest % 64);
+    if (prereqId == 0) {
+        ownRoots_[quest / 64] |= bit;
+        return;
+    }
+    ownRoots_[quest / 64] &= ~bit;
+    const uint32_t prereq = Find(prereqId);
+    if (prereq != kNoQuest)
+        ownDependents_[prereq].push_back(quest);
+    else
+        pendingDependents_[prereqId].push_back(quest);
+}
+
+void QuestPack::UnlinkPrerequisite(uint32_t quest, QuestId prerequisite) {
+    if (prerequisite == 0) return;
+    const uint32_t prereq = Find(prerequisite);
+    std::vector<uint32_t>* edges = nullptr;
+    if (prereq != kNoQuest) {
+        edges = &ownDependents_[prereq];
+    } else {
+        auto it = pendingDependents_.find(prerequisite);
+        if (it == pendingDependents_.end()) return;
+        edges = &it->second;
+    }
+    edges->erase(std::remove(edges->begin(), edges->end(), quest), edges->end());
+}
+
+bool QuestPack::Add(const QuestDefinition& def) {
+    if (!editable_ || def.id == 0 || def.objectives.size() > kMaxObjectives) return false;
+    if (CreatesCycle(def.id, def.prerequisiteQuestId)) return false;
+    for (const auto& obj : def.objectives)
+        if (InternSymbol(obj.targetId) == kNoSymbol) return false;  // hash collision with another tag
+
+    PackQuest rec;
+    rec.id = def.id;
+    rec.prerequisite = def.prerequisiteQuestId;
+    rec.rewardPoints = def.rewardPoints;
+    rec.category = def.category;
+    rec.title = AddString(def.title);
+    rec.description = AddString(def.description);
+    rec.firstObjective = static_cast<uint32_t>(ownObjectives_.size());
+    rec.objectiveCount = static_cast<uint8_t>(def.objectives.size());
+    for (const auto& obj : def.objectives) {
+        PackObjective po;
+        po.id = obj.id;
+        po.target = obj.target;
+        po.initial = obj.current;
+        po.targetSymbol = SymbolHash(obj.targetId);
+        po.targetId = AddString(obj.targetId);
+        po.type = obj.type;
+        po.optional = obj.optional ? 1 : 0;
+        ownObjectives_.push_back(po);
+    }
+
+    auto it = std::lower_bound(ownIndex_.begin(), ownIndex_.end(), def.id,
+                               [](const PackQuestIndex& entry, QuestId key) { return entry.id < key; });
+    if (it != ownIndex_.end() && it->id == def.id) {
+        const uint32_t quest = it->quest;
+        const QuestId oldPrerequisite = ownQuests_[quest].prerequisite;
+        ownQuests_[quest] = rec;
+        if (rec.prerequisite != oldPrerequisite) {
+            UnlinkPrerequisite(quest, oldPrerequisite);
+            LinkPrerequisite(quest);
+        }
+    } else {
+        const uint32_t quest = static_cast<uint32_t>(ownQuests_.size());
+        ownIndex_.insert(it, PackQuestIndex{ def.id, quest });
+        ownQuests_.push_back(rec);
+        ownDependents_.emplace_back();
+        Refresh();  // LinkPrerequisite looks ids up through the views
+        // Quests added earlier may already name this one.
+        auto pending = pendingDependents_.find(def.id);
+        if (pending != pendingDependents_.end()) {
+            ownDependents_[quest] = std::move(pending->second);
+            pendingDependents_.erase(pending);
+        }
+        LinkPrerequisite(quest);
+    }
+    Refresh();
+    return true;
+}
+
+bool QuestPack::Write(const std::string& path) const {
+    // Lay the tables out afresh: replaced quests' objectives and strings
+    // are dropped and dependents become contiguous edge ranges.
+    std::vector<PackQuest> quests(quests_.begin(), quests_.end());
+    std::vector<PackObjective> objectives;
+    std::vector<uint32_t> edges;
+    std::string strings;
+    auto copyString = [&](PackString s) {
+        PackString out{ static_cast<uint32_t>(strings.size()), s.length };
+        strings.append(String(s));
+        return out;
+    };
+    for (uint32_t q = 0; q < quests.size(); ++q) {
+        PackQuest& rec = quests[q];
+        rec.title = copyString(rec.title);
+        rec.description = copyString(rec.description);
+        Span<const PackObjective> objs = Objectives(q);
+        rec.firstObjective = static_cast<uint32_t>(objectives.size());
+        for (PackObjective obj : objs) {
+            obj.targetId = copyString(obj.targetId);
+            objectives.push_back(obj);
+        }
+        Span<const uint32_t> dependents = Dependents(q);
+        rec.firstDependent = static_cast<uint32_t>(edges.size());
+        rec.dependentCount = static_cast<uint32_t>(dependents.size());
+        edges.insert(edges.end(), dependents.begin(), dependents.end());
+    }
+
+    QuestPackHeader header;
+    header.questCount = static_cast<uint32_t>(quests.size());
+    header.objectiveCount = static_cast<uint32_t>(objectives.size());
+    header.edgeCount = static_cast<uint32_t>(edges.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+    header.questsOffset = AlignUp(sizeof(header));
+    header.objectivesOffset = AlignUp(header.questsOffset + quests.size() * sizeof(PackQuest));
+    header.indexOffset = AlignUp(header.objectivesOffset + objectives.size() * sizeof(PackObjective));
+    header.edgesOffset = AlignUp(header.indexOffset + index_.size() * sizeof(PackQuestIndex));
+    header.rootsOffset = AlignUp(header.edgesOffset + edges.size() * sizeof(uint32_t));
+    header.stringsOffset = AlignUp(header.rootsOffset + roots_.size() * sizeof(uint64_t));
+    header.fileSize = header.stringsOffset + strings.size();
+
+    // Written beside the target and renamed over it, so a server mapping
+    // the old pack never sees a partial file.
+    const std::string temp = path + ".tmp";
+    std::FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) return false;
+    const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                    WriteTable(file, header.questsOffset, quests.data(), quests.size()) &&
+                    WriteTable(file, header.objectivesOffset, objectives.data(), objectives.size()) &&
+                    WriteTable(file, header.indexOffset, index_.data(), index_.size()) &&
+                    WriteTable(file, header.edgesOffset, edges.data(), edges.size()) &&
+                    WriteTable(file, header.rootsOffset, roots_.data(), roots_.size()) &&
+                    WriteTable(file, header.stringsOffset, strings.data(), strings.size()) &&
+                    SyncFile(file);
+    if (std::fclose(file) != 0 || !ok) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+QuestObjective QuestPack::ToObjective(const PackObjective& obj) const {
+    QuestObjective out;
+    out.id = obj.id;
+    out.type = obj.type;
+    out.current = obj.initial;
+    out.target = obj.target;
+    out.targetId = std::string(String(obj.targetId));
+    out.optional = obj.optional != 0;
+    out.targetSymbol = obj.targetSymbol;
+    return out;
+}
+
+void QuestPack::Materialize(uint32_t quest, QuestDefinition& out) const {
+    const PackQuest& rec = quests_[quest];
+    out.id = rec.id;
+    out.category = rec.category;
+    out.title = std::string(String(rec.title));
+    out.description = std::string(String(rec.description));
+    out.rewardPoints = rec.rewardPoints;
+    out.prerequisiteQuestId = rec.prerequisite;
+    out.objectives.clear();
+    for (const PackObjective& obj : Objectives(quest))
+        out.objectives.push_back(ToObjective(obj));
+}
+
+} // namespace game
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "MappedFile.h"
+#include "Span.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+// Pack records. The file is a header followed by these arrays (8-byte
+// aligned, host byte order), and QuestSystem reads them in place.
+struct PackString {
+    uint32_t offset = 0;  // into the string table
+    uint32_t length = 0;
+};
+
+struct PackQuest {
+    QuestId id = 0;
+    QuestId prerequisite = 0;    // 0 = none
+    int32_t rewardPoints = 0;
+    uint32_t firstObjective = 0;
+    uint32_t firstDependent = 0;  // quests this one unlocks, in the edge array
+    uint32_t dependentCount = 0;
+    PackString title;
+    PackString description;
+    QuestCategory category = QuestCategory::Land;
+    uint8_t objectiveCount = 0;
+    uint16_t reserved = 0;
+};
+static_assert(sizeof(PackQuest) == 44, "PackQuest is written to disk as-is");
+
+struct PackObjective {
+    ObjectiveId id = 0;
+    int32_t target = 0;
+    int32_t initial = 0;           // QuestObjective::current when the quest starts
+    SymbolId targetSymbol = kNoSymbol;
+    PackString targetId;
+    QuestObjectiveType type = QuestObjectiveType::Kill;
+    uint8_t optional = 0;
+    uint16_t reserved = 0;
+};
+static_assert(sizeof(PackObjective) == 28, "PackObjective is written to disk as-is");
+
+struct PackQuestIndex {
+    QuestId id = 0;
+    uint32_t quest = 0;  // dense index
+};
+
+struct QuestPackHeader {
+    char magic[8] = { 'Q', 'S', 'T', 'P', 'A', 'C', 'K', '1' };
+    uint32_t questCount = 0;
+    uint32_t objectiveCount = 0;
+    uint32_t edgeCount = 0;
+    uint32_t stringBytes = 0;
+    uint64_t questsOffset = 0;      // PackQuest[questCount], dense order
+    uint64_t objectivesOffset = 0;  // PackObjective[objectiveCount]
+    uint64_t indexOffset = 0;       // PackQuestIndex[questCount], sorted by id
+    uint64_t edgesOffset = 0;       // uint32_t[edgeCount], dependents grouped by prerequisite
+    uint64_t rootsOffset = 0;       // uint64_t[(questCount + 63) / 64], quests without a prerequisite
+    uint64_t stringsOffset = 0;     // char[stringBytes]
+    uint64_t fileSize = 0;
+};
+static_assert(sizeof(QuestPackHeader) == 80, "QuestPackHeader is written to disk as-is");
+
+// ---------------------------------------------------------------------------
+// Compiled quest content: dense quest records, flat objective array, id
+// index, prerequisite graph (each quest's dependents) and a string table.
+//
+// A pack opened from disk is a validated memory map; the tables are used
+// where they lie, so loading costs one pass of bounds checks and no
+// allocation per quest. An editable pack (default-constructed or Clone)
+// holds the same tables in vectors and accepts Add; Write lays it out as a
+// file. Target symbols are hashed by the compiler (which rejects
+// collisions) and are not re-interned on load.
+// ---------------------------------------------------------------------------
+class QuestPack {
+public:
+    static constexpr uint32_t kNoQuest = UINT32_MAX;
+    static constexpr size_t kMaxObjectives = 255;  // objective index is 8 bits
+
+    QuestPack() = default;
+
+    QuestPack(const QuestPack&) = delete;
+    QuestPack& operator=(const QuestPack&) = delete;
+
+    // nullptr if the file is missing, not a pack or has out-of-range tables.
+    static std::shared_ptr<const QuestPack> Open(const std::string& path);
+    // Editable copy of any pack.
+    std::shared_ptr<QuestPack> Clone() const;
+
+    // Adds a quest or replaces the one with its id; false (and unchanged) if
+    // the id is 0, the objectives don't fit, a target tag collides with
+    // another symbol or the prerequisite chain would lead back to the quest.
+    // Editable packs only.
+    bool Add(const QuestDefinition& def);
+    bool Write(const std::string& path) const;
+
+    uint32_t QuestCount() const { return static_cast<uint32_t>(quests_.size()); }
+    const PackQuest& Quest(uint32_t quest) const { return quests_[quest]; }
+    Span<const PackObjective> Objectives(uint32_t quest) const {
+        return Span<const PackObjective>(objectives_.data() + quests_[quest].firstObjective,
+                                         quests_[quest].objectiveCount);
+    }
+    Span<const uint32_t> Dependents(uint32_t quest) const;
+    Span<const uint64_t> RootWords() const { return roots_; }
+    std::string_view String(PackString s) const { return std::string_view(strings_.data() + s.offset, s.length); }
+    uint32_t Find(QuestId id) const;  // dense index, or kNoQuest
+    QuestObjective ToObjective(const PackObjective& obj) const;
+    void Materialize(uint32_t quest, QuestDefinition& out) const;
+
+private:
+    bool Map(MappedFile file);
+    void Refresh();  // points the table views at the owned vectors
+    PackString AddString(std::string_view text);
+    bool CreatesCycle(QuestId id, QuestId prerequisite) const;
+    void LinkPrerequisite(uint32_t quest);
+    void UnlinkPrerequisite(uint32_t quest, QuestId prerequisite);
+
+    // Table views, into file_ or the owned vectors below.
+    Span<const PackQuest> quests_;
+    Span<const PackObjective> objectives_;
+    Span<const PackQuestIndex> index_;
+    Span<const uint32_t> edges_;
+    Span<const uint64_t> roots_;
+    Span<const char> strings_;
+
+    MappedFile file_;
+    bool editable_ = true;
+    std::vector<PackQuest> ownQuests_;
+    std::vector<PackObjective> ownObjectives_;  // replaced quests leave their old range behind
+    std::vector<PackQuestIndex> ownIndex_;
+    std::vector<std::vector<uint32_t>> ownDependents_;  // edges_ is unused while editable
+    std::unordered_map<QuestId, std::vector<uint32_t>> pendingDependents_;  // prerequisite not added yet
+    std::vector<uint64_t> ownRoots_;
+    std::string ownStrings_;
+};
+
+} // namespace game
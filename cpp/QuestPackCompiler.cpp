@@ -0,0 +1,304 @@
+/**
+ * Virtual Sim — quest pack compiler
+ * Reads a quest source file (format described at the top of quests.txt) and
+ * writes the binary pack QuestSystem maps at startup or hot-swaps between
+ * ticks (QuestPack::Open, GameServer::StageQuestPack). Errors are reported
+ * as file:line and leave any existing output untouched.
+ *
+ * With --cpp it writes C++ instead: QuestData.h's RegisterAllQuests (the
+ * built-in fallback when no pack is found) registering the same quests. The
+ * build generates QuestData.cpp this way, so quest content is edited only in
+ * the source file.
+ *
+ * Usage: quest_packc [--cpp] <source.txt> <output.qpack | output.cpp>
+ */
+
+#include "QuestPack.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_set>
+
+using namespace game;
+
+namespace {
+
+struct ObjectiveTypeName {
+    const char* name;
+    QuestObjectiveType type;
+};
+
+const ObjectiveTypeName kObjectiveTypes[] = {
+    { "kill", QuestObjectiveType::Kill },
+    { "collect", QuestObjectiveType::Collect },
+    { "reach_location", QuestObjectiveType::ReachLocation },
+    { "interact", QuestObjectiveType::Interact },
+    { "deliver", QuestObjectiveType::Deliver },
+    { "survive_rounds", QuestObjectiveType::SurviveRounds },
+    { "win_matches", QuestObjectiveType::WinMatches },
+};
+
+bool ParseObjectiveType(const std::string& name, QuestObjectiveType& out) {
+    for (const auto& entry : kObjectiveTypes) {
+        if (name == entry.name) {
+            out = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rest of the line after the keyword, without surrounding blanks.
+std::string RestOfLine(std::istringstream& in) {
+    std::string rest;
+    std::getline(in >> std::ws, rest);
+    while (!rest.empty() && (rest.back() == ' ' || rest.back() == '\t' || rest.back() == '\r')) rest.pop_back();
+    return rest;
+}
+
+class Compiler {
+public:
+    explicit Compiler(std::string path) : path_(std::move(path)) {}
+
+    bool Run(std::istream& in) {
+        std::string line;
+        while (std::getline(in, line)) {
+            ++line_;
+            std::istringstream words(line);
+            std::string keyword;
+            if (!(words >> keyword) || keyword[0] == '#') continue;
+            if (!Statement(keyword, words)) return false;
+        }
+        if (inQuest_) return Error("quest " + std::to_string(def_.id) + " has no 'end'");
+        return true;
+    }
+
+    const QuestPack& Pack() const { return pack_; }
+    size_t ObjectiveCount() const { return objectives_; }
+
+private:
+    bool Error(const std::string& message) const {
+        std::fprintf(stderr, "%s:%d: %s\n", path_.c_str(), line_, message.c_str());
+        return false;
+    }
+
+    bool Statement(const std::string& keyword, std::istringstream& words) {
+        if (keyword == "quest") {
+            if (inQuest_) return Error("'quest' inside quest " + std::to_string(def_.id));
+            def_ = QuestDefinition{};
+            if (!(words >> def_.id) || def_.id == 0) return Error("expected a nonzero quest id");
+            if (!ids_.insert(def_.id).second) return Error("duplicate quest id " + std::to_string(def_.id));
+            inQuest_ = true;
+            return true;
+        }
+        if (!inQuest_) return Error("'" + keyword + "' outside a quest block");
+        if (keyword == "end") {
+            inQuest_ = false;
+            objectives_ += def_.objectives.size();
+            if (!pack_.Add(def_))
+                return Error("quest " + std::to_string(def_.id) +
+                             " rejected (too many objectives, tag hash collision or prerequisite cycle)");
+            return true;
+        }
+        if (keyword == "category") {
+            std::string category;
+            words >> category;
+            if (category == "land")
+                def_.category = QuestCategory::Land;
+            else if (category == "space")
+                def_.category = QuestCategory::OuterSpace;
+            else
+                return Error("category must be 'land' or 'space'");
+            return true;
+        }
+        if (keyword == "title") {
+            def_.title = RestOfLine(words);
+            return true;
+        }
+        if (keyword == "description") {
+            def_.description = RestOfLine(words);
+            return true;
+        }
+        if (keyword == "reward") {
+            if (!(words >> def_.rewardPoints)) return Error("expected reward points");
+            return true;
+        }
+        if (keyword == "prerequisite") {
+            if (!(words >> def_.prerequisiteQuestId)) return Error("expected a prerequisite quest id");
+            return true;
+        }
+        if (keyword == "objective") {
+            QuestObjective obj;
+            std::string type;
+            if (!(words >> obj.id >> type >> obj.target >> obj.targetId))
+                return Error("expected: objective <id> <type> <target> <tag | ->");
+            if (!ParseObjectiveType(type, obj.type)) return Error("unknown objective type '" + type + "'");
+            if (obj.targetId == "-") obj.targetId.clear();
+            std::string flag;
+            if (words >> flag) {
+                if (flag != "optional") return Error("unexpected '" + flag + "'");
+                obj.optional = true;
+            }
+            for (const auto& other : def_.objectives)
+                if (other.id == obj.id) return Error("duplicate objective id " + std::to_string(obj.id));
+            def_.objectives.push_back(std::move(obj));
+            return true;
+        }
+        return Error("unknown keyword '" + keyword + "'");
+    }
+
+    std::string path_;
+    int line_ = 0;
+    bool inQuest_ = false;
+    QuestDefinition def_;
+    std::unordered_set<QuestId> ids_;
+    size_t objectives_ = 0;
+    QuestPack pack_;
+};
+
+const char* ObjectiveTypeSource(QuestObjectiveType type) {
+    switch (type) {
+    case QuestObjectiveType::Kill: return "Kill";
+    case QuestObjectiveType::Collect: return "Collect";
+    case QuestObjectiveType::ReachLocation: return "ReachLocation";
+    case QuestObjectiveType::Interact: return "Interact";
+    case QuestObjectiveType::Deliver: return "Deliver";
+    case QuestObjectiveType::SurviveRounds: return "SurviveRounds";
+    case QuestObjectiveType::WinMatches: return "WinMatches";
+    }
+    return "Kill";
+}
+
+// C++ string literal for text (quotes, backslashes and non-ASCII escaped).
+std::string Literal(const std::string& text) {
+    std::string out = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20 || c >= 0x7F) {
+            char octal[8];
+            std::snprintf(octal, sizeof(octal), "\\%03o", c);
+            out += octal;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    return out + "\"";
+}
+
+void WriteRegisterFunction(std::ostream& out, const QuestPack& pack, const char* name, QuestCategory category) {
+    out << "void " << name << "(QuestSystem& quests) {\n";
+    QuestDefinition def;
+    for (uint32_t q = 0; q < pack.QuestCount(); ++q) {
+        pack.Materialize(q, def);
+        if (def.category != category) continue;
+        out << "    Add(quests, " << def.id << ", QuestCategory::"
+            << (category == QuestCategory::Land ? "Land" : "OuterSpace") << ", " << Literal(def.title) << ",\n"
+            << "        " << Literal(def.description) << ", " << def.rewardPoints << ", "
+            << def.prerequisiteQuestId << ", {\n";
+        for (const QuestObjective& obj : def.objectives)
+            out << "            { " << obj.id << ", QuestObjectiveType::" << ObjectiveTypeSource(obj.type) << ", "
+                << obj.current << ", " << obj.target << ", " << Literal(obj.targetId) << ", "
+                << (obj.optional ? "true" : "false") << " },\n";
+        out << "        });\n";
+    }
+    out << "}\n\n";
+}
+
+// Writes the RegisterAllQuests translation unit (QuestData.h) for the pack,
+// in pack order: the built-in fallback is generated from the same source as
+// the pack, so quest content is only ever edited in the text file.
+bool WriteRegistration(const std::string& sourcePath, const std::string& path, const QuestPack& pack) {
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out << "// Generated by quest_packc from " << std::filesystem::path(sourcePath).filename().string()
+            << "; edit that file, not this one.\n"
+               "#include \"QuestData.h\"\n"
+               "#include <initializer_list>\n"
+               "\n"
+               "namespace game {\n"
+               "\n"
+               "namespace {\n"
+               "\n"
+               "void Add(QuestSystem& quests, QuestId id, QuestCategory category, const char* title, const char* description,\n"
+               "         int32_t reward, QuestId prerequisite, std::initializer_list<QuestObjective> objectives) {\n"
+               "    QuestDefinition def;\n"
+               "    def.id = id;\n"
+               "    def.category = category;\n"
+               "    def.title = title;\n"
+               "    def.description = description;\n"
+               "    def.rewardPoints = reward;\n"
+               "    def.prerequisiteQuestId = prerequisite;\n"
+               "    def.objectives.assign(objectives.begin(), objectives.end());\n"
+               "    quests.RegisterQuest(def);\n"
+               "}\n"
+               "\n"
+               "} // namespace\n"
+               "\n";
+        WriteRegisterFunction(out, pack, "RegisterLandQuests", QuestCategory::Land);
+        WriteRegisterFunction(out, pack, "RegisterSpaceQuests", QuestCategory::OuterSpace);
+        out << "void RegisterAllQuests(QuestSystem& quests) {\n"
+               "    RegisterLandQuests(quests);\n"
+               "    RegisterSpaceQuests(quests);\n"
+               "}\n"
+               "\n"
+               "} // namespace game\n";
+        if (!out.flush()) {
+            out.close();
+            std::remove(temp.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) std::remove(temp.c_str());
+    return !ec;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool cpp = argc == 4 && std::strcmp(argv[1], "--cpp") == 0;
+    if (argc != 3 && !cpp) {
+        std::fprintf(stderr, "usage: quest_packc [--cpp] <source.txt> <output.qpack | output.cpp>\n");
+        return 2;
+    }
+    const char* sourcePath = argv[argc - 2];
+    const char* outputPath = argv[argc - 1];
+    std::ifstream in(sourcePath);
+    if (!in) {
+        std::fprintf(stderr, "quest_packc: cannot read %s\n", sourcePath);
+        return 1;
+    }
+    Compiler compiler(sourcePath);
+    if (!compiler.Run(in)) return 1;
+
+    const QuestPack& pack = compiler.Pack();
+    for (uint32_t q = 0; q < pack.QuestCount(); ++q) {
+        const QuestId prereq = pack.Quest(q).prerequisite;
+        if (prereq != 0 && pack.Find(prereq) == QuestPack::kNoQuest)
+            std::fprintf(stderr, "quest_packc: warning: quest %u requires unknown quest %u and can never unlock\n",
+                         pack.Quest(q).id, prereq);
+    }
+    if (cpp) {
+        if (!WriteRegistration(sourcePath, outputPath, pack)) {
+            std::fprintf(stderr, "quest_packc: cannot write %s\n", outputPath);
+            return 1;
+        }
+        std::printf("%s: RegisterAllQuests with %u quests\n", outputPath, pack.QuestCount());
+        return 0;
+    }
+    if (!pack.Write(outputPath)) {
+        std::fprintf(stderr, "quest_packc: cannot write %s\n", outputPath);
+        return 1;
+    }
+    std::printf("%s: %u quests, %zu objectives\n", outputPath, pack.QuestCount(), compiler.ObjectiveCount());
+    return 0;
+}
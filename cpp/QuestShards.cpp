@@ -0,0 +1,143 @@
+#include "QuestShards.h"
+#include <algorithm>
+
+namespace game {
+
+ShardedQuestSystem::ShardedQuestSystem(size_t shardCount) {
+    shardCount = std::max<size_t>(shardCount, 1);
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+        Shard* shard = shards_.back().get();
+        shard->quests.SetEventCallback([this, shard](PlayerId playerId, QuestId questId, QuestState state) {
+            if (shard->inBatch)
+                shard->changes.push_back(TaggedChange{ shard->currentEvent, { playerId, questId, state } });
+            else if (onQuestEvent_)
+                onQuestEvent_(playerId, questId, state);
+        });
+    }
+    workers_.reserve(shardCount - 1);
+    for (size_t i = 1; i < shardCount; ++i)
+        workers_.emplace_back(&ShardedQuestSystem::WorkerLoop, this, i);
+}
+
+ShardedQuestSystem::~ShardedQuestSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+size_t ShardedQuestSystem::ShardOf(PlayerId playerId) const {
+    // Fibonacci hashing spreads sequential ids evenly.
+    const uint64_t h = (static_cast<uint64_t>(playerId) * 0x9E3779B97F4A7C15ull) >> 32;
+    return static_cast<size_t>(h % shards_.size());
+}
+
+void ShardedQuestSystem::AttachAnalytics(ProgressionAnalytics* analytics) {
+    for (size_t i = 0; i < shards_.size(); ++i) shards_[i]->quests.SetAnalytics(analytics, i);
+}
+
+void ShardedQuestSystem::RegisterQuest(const QuestDefinition& def) {
+    for (auto& shard : shards_) shard->quests.RegisterQuest(def);
+}
+
+void ShardedQuestSystem::UsePack(const std::shared_ptr<const QuestPack>& pack) {
+    for (auto& shard : shards_) shard->quests.UsePack(pack);
+}
+
+bool ShardedQuestSystem::StartQuest(PlayerId playerId, QuestId questId) {
+    return ShardFor(playerId).StartQuest(playerId, questId);
+}
+
+void ShardedQuestSystem::AbandonQuest(PlayerId playerId, QuestId questId) {
+    ShardFor(playerId).AbandonQuest(playerId, questId);
+}
+
+QuestState ShardedQuestSystem::GetQuestState(PlayerId playerId, QuestId questId) const {
+    return ShardFor(playerId).GetQuestState(playerId, questId);
+}
+
+std::vector<QuestId> ShardedQuestSystem::GetAvailableQuests(PlayerId playerId) const {
+    return ShardFor(playerId).GetAvailableQuests(playerId);
+}
+
+void ShardedQuestSystem::RunShard(Shard& shard) {
+    shard.inBatch = true;
+    for (uint32_t index : shard.events) {
+        const QuestEvent& ev = batch_[index];
+        shard.currentEvent = index;
+        switch (ev.type) {
+        case QuestEventType::Kill:          shard.quests.NotifyKill(ev.playerId, ev.target); break;
+        case QuestEventType::Collect:       shard.quests.NotifyCollect(ev.playerId, ev.target); break;
+        case QuestEventType::ReachLocation: shard.quests.NotifyReachLocation(ev.playerId, ev.target); break;
+        case QuestEventType::Interact:      shard.quests.NotifyInteract(ev.playerId, ev.target); break;
+        case QuestEventType::SurviveRounds: shard.quests.NotifySurviveRounds(ev.playerId, ev.value); break;
+        case QuestEventType::WinMatch:
+            shard.quests.NotifyWinMatch(ev.playerId, static_cast<GameMode>(ev.value));
+            break;
+        }
+    }
+    shard.inBatch = false;
+}
+
+void ShardedQuestSystem::WorkerLoop(size_t shardIndex) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        RunShard(*shards_[shardIndex]);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+}
+
+void ShardedQuestSystem::IngestBatch(Span<const QuestEvent> events, std::vector<QuestStateChange>& changes) {
+    if (events.empty()) return;
+
+    for (auto& shard : shards_) {
+        shard->events.clear();
+        shard->changes.clear();
+    }
+    for (size_t i = 0; i < events.size(); ++i)
+        shards_[ShardOf(events[i].playerId)]->events.push_back(static_cast<uint32_t>(i));
+    batch_ = events;
+
+    // The mutex hand-off orders the routing above before the workers run
+    // and their results before the merge below.
+    if (!workers_.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+    }
+    RunShard(*shards_[0]);
+    if (!workers_.empty()) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return pending_ == 0; });
+    }
+    batch_ = Span<const QuestEvent>();
+
+    // Each shard's list is already in event order and one event's changes
+    // come from a single shard, so a stable sort by event index is the
+    // single-threaded order.
+    merged_.clear();
+    for (auto& shard : shards_)
+        merged_.insert(merged_.end(), shard->changes.begin(), shard->changes.end());
+    std::stable_sort(merged_.begin(), merged_.end(),
+                     [](const TaggedChange& a, const TaggedChange& b) { return a.event < b.event; });
+    for (const TaggedChange& tagged : merged_)
+        changes.push_back(tagged.change);
+}
+
+} // namespace game
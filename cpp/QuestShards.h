@@ -0,0 +1,115 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "Quest.h"
+#include "Span.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Quest progress split across worker-owned shards. Players are assigned to a
+// shard by PlayerId; each shard is a full QuestSystem holding only its
+// players, and is only ever touched by one thread at a time, so QuestSystem
+// itself stays lock-free and unchanged.
+//
+// IngestBatch routes a tick's events to their shards, runs the shards in
+// parallel (shard 0 on the calling thread), then merges the resulting state
+// changes by input event order. Players never span shards, so the merged list
+// is exactly what one QuestSystem would report for the same events in order.
+// ---------------------------------------------------------------------------
+enum class QuestEventType : uint8_t {
+    Kill,
+    Collect,
+    ReachLocation,
+    Interact,
+    SurviveRounds,
+    WinMatch
+};
+
+struct QuestEvent {
+    PlayerId playerId = 0;
+    QuestEventType type = QuestEventType::Kill;
+    SymbolId target = kNoSymbol;  // Kill / Collect / ReachLocation / Interact
+    int32_t value = 0;            // rounds (SurviveRounds) or GameMode (WinMatch)
+};
+
+struct QuestStateChange {
+    PlayerId playerId = 0;
+    QuestId questId = 0;
+    QuestState state = QuestState::Locked;
+};
+
+class ShardedQuestSystem {
+public:
+    // shardCount is clamped to at least 1; shards 1.. get a worker thread.
+    explicit ShardedQuestSystem(size_t shardCount);
+    ~ShardedQuestSystem();
+
+    ShardedQuestSystem(const ShardedQuestSystem&) = delete;
+    ShardedQuestSystem& operator=(const ShardedQuestSystem&) = delete;
+
+    size_t ShardCount() const { return shards_.size(); }
+    size_t ShardOf(PlayerId playerId) const;
+
+    // Registers the quest on every shard. Like the per-player calls below,
+    // not to be called while IngestBatch runs.
+    void RegisterQuest(const QuestDefinition& def);
+    // Switches every shard to the pack; the shards share its mapping.
+    void UsePack(const std::shared_ptr<const QuestPack>& pack);
+
+    // Per-player calls forward to the owning shard on the calling thread;
+    // their state changes go to the event callback.
+    bool StartQuest(PlayerId playerId, QuestId questId);
+    void AbandonQuest(PlayerId playerId, QuestId questId);
+    QuestState GetQuestState(PlayerId playerId, QuestId questId) const;
+    std::vector<QuestId> GetAvailableQuests(PlayerId playerId) const;
+    QuestSystem& ShardFor(PlayerId playerId) { return shards_[ShardOf(playerId)]->quests; }
+    const QuestSystem& ShardFor(PlayerId playerId) const { return shards_[ShardOf(playerId)]->quests; }
+    void SetEventCallback(QuestSystem::QuestEventCallback cb) { onQuestEvent_ = std::move(cb); }
+    // Shard i records its quest events as analytics producer i, so the
+    // stream needs ShardCount() producers. Not while IngestBatch runs.
+    void AttachAnalytics(ProgressionAnalytics* analytics);
+
+    // Applies events in parallel across shards and appends the state changes
+    // they caused to changes, ordered by triggering event (then by the order
+    // the shard reported them). Events for one player apply in input order.
+    void IngestBatch(Span<const QuestEvent> events, std::vector<QuestStateChange>& changes);
+
+private:
+    struct TaggedChange {
+        uint32_t event = 0;  // index into the batch
+        QuestStateChange change;
+    };
+    struct Shard {
+        QuestSystem quests;
+        std::vector<uint32_t> events;  // this batch's event indices, in input order
+        std::vector<TaggedChange> changes;
+        uint32_t currentEvent = 0;
+        bool inBatch = false;
+    };
+
+    void RunShard(Shard& shard);
+    void WorkerLoop(size_t shardIndex);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::thread> workers_;
+    QuestSystem::QuestEventCallback onQuestEvent_;
+
+    Span<const QuestEvent> batch_;
+    std::vector<TaggedChange> merged_;  // IngestBatch scratch
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;  // bumped per batch
+    size_t pending_ = 0;       // workers still running the batch
+    bool stop_ = false;
+};
+
+} // namespace game
@@ -0,0 +1,566 @@
+#include "QuestStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace game {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kSnapshotMagic[8] = { 'Q', 'S', 'T', 'S', 'N', 'A', 'P', '3' };
+constexpr uint32_t kFrameMagic = 0x514C4732u;  // "QLG2"
+constexpr size_t kCopyChunk = 4096;            // records per buffered snapshot write
+
+struct SnapshotHeader {
+    char magic[8];
+    uint64_t firstSegment;  // first log segment not folded into this snapshot
+    uint64_t playerCount;
+    uint64_t recordCount;
+    uint64_t indexOffset;
+    uint32_t crc;           // CRC-32 of everything after the header
+    uint32_t reserved;
+};
+// Records follow the header; the index (sorted by player) follows the records,
+// aligned up to 8 bytes.
+struct SnapshotIndexEntry {
+    PlayerId playerId;
+    uint32_t count;
+    uint64_t firstRecord;
+};
+uint64_t IndexOffset(uint64_t recordCount) {
+    const uint64_t end = sizeof(SnapshotHeader) + recordCount * sizeof(QuestLogRecord);
+    return (end + alignof(SnapshotIndexEntry) - 1) & ~uint64_t{ alignof(SnapshotIndexEntry) - 1 };
+}
+struct FrameHeader {
+    uint32_t magic;
+    uint32_t count;
+    uint32_t crc;  // CRC-32 of the frame's records
+    uint32_t reserved;
+};
+static_assert(sizeof(SnapshotHeader) % alignof(QuestLogRecord) == 0, "records must stay aligned");
+
+// CRC-32; pass the previous result as crc to continue a running checksum.
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0) {
+    static const auto table = [] {
+        struct Table { uint32_t v[256]; } t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t.v[i] = c;
+        }
+        return t;
+    }();
+    crc ^= 0xFFFFFFFFu;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) crc = table.v[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Parses "quests-<n><ext>"; false for anything else.
+bool ParseSequence(const std::string& name, const char* ext, uint64_t& out) {
+    const std::string prefix = "quests-";
+    const size_t extLen = std::strlen(ext);
+    if (name.size() <= prefix.size() + extLen || name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - extLen, extLen, ext) != 0)
+        return false;
+    uint64_t value = 0;
+    for (size_t i = prefix.size(); i < name.size() - extLen; ++i) {
+        if (name[i] < '0' || name[i] > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(name[i] - '0');
+    }
+    out = value;
+    return true;
+}
+
+// Checks a mapped snapshot once, so SnapshotRecords can trust its index:
+// header, exact size, checksum over records and index, index sorted by
+// player with every run inside the record table.
+bool ValidSnapshot(const MappedFile& file, uint64_t segment) {
+    SnapshotHeader header;
+    if (file.Size() < sizeof(header)) return false;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    const uint64_t body = file.Size() - sizeof(header);
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 || header.firstSegment != segment ||
+        header.recordCount > body / sizeof(QuestLogRecord) || header.playerCount > body / sizeof(SnapshotIndexEntry))
+        return false;
+    const uint64_t indexOffset = IndexOffset(header.recordCount);
+    if (header.indexOffset != indexOffset ||
+        file.Size() != indexOffset + header.playerCount * sizeof(SnapshotIndexEntry) ||
+        Crc32(file.Data() + sizeof(header), static_cast<size_t>(body)) != header.crc)
+        return false;
+    const auto* index = reinterpret_cast<const SnapshotIndexEntry*>(file.Data() + indexOffset);
+    for (uint64_t i = 0; i < header.playerCount; ++i) {
+        const SnapshotIndexEntry& entry = index[i];
+        if ((i > 0 && index[i - 1].playerId >= entry.playerId) || entry.firstRecord > header.recordCount ||
+            entry.count > header.recordCount - entry.firstRecord)
+            return false;
+    }
+    return true;
+}
+
+struct QuestFold {
+    QuestId quest = 0;
+    QuestState state = QuestState::Locked;
+    int32_t startedAt = 0;
+    std::vector<std::pair<ObjectiveId, int32_t>> counters;  // set while InProgress
+};
+
+// Reduces a player's records (in log order) to the minimum that restores the
+// same state: per quest, its last state and, if in progress, its counters.
+void FoldRecords(Span<const QuestLogRecord> records, std::vector<QuestFold>& folds,
+                 std::vector<QuestLogRecord>& out) {
+    folds.clear();
+    for (const QuestLogRecord& rec : records) {
+        auto it = std::find_if(folds.begin(), folds.end(), [&](const QuestFold& f) { return f.quest == rec.questId; });
+        if (it == folds.end()) {
+            if (rec.op != QuestLogOp::State) continue;
+            folds.emplace_back();
+            it = folds.end() - 1;
+            it->quest = rec.questId;
+        }
+        if (rec.op == QuestLogOp::State) {
+            it->state = rec.state;
+            it->startedAt = rec.state == QuestState::InProgress ? rec.value : 0;
+            it->counters.clear();
+        } else if (it->state == QuestState::InProgress) {
+            auto c = std::find_if(it->counters.begin(), it->counters.end(),
+                                  [&](const std::pair<ObjectiveId, int32_t>& p) { return p.first == rec.objectiveId; });
+            if (c != it->counters.end())
+                c->second = rec.value;
+            else
+                it->counters.emplace_back(rec.objectiveId, rec.value);
+        }
+    }
+
+    out.clear();
+    if (records.empty()) return;
+    const PlayerId playerId = records[0].playerId;
+    for (auto& fold : folds) {
+        QuestLogRecord rec;
+        rec.playerId = playerId;
+        rec.questId = fold.quest;
+        rec.op = QuestLogOp::State;
+        rec.state = fold.state;
+        rec.value = fold.startedAt;
+        out.push_back(rec);
+        std::sort(fold.counters.begin(), fold.counters.end());
+        for (const auto& [objective, value] : fold.counters) {
+            rec.op = QuestLogOp::Counter;
+            rec.state = QuestState::InProgress;
+            rec.objectiveId = objective;
+            rec.value = value;
+            out.push_back(rec);
+        }
+    }
+}
+
+} // namespace
+
+std::string QuestProgressStore::SegmentPath(uint64_t segment) const {
+    return (fs::path(options_.directory) / ("quests-" + std::to_string(segment) + ".wal")).string();
+}
+
+std::string QuestProgressStore::SnapshotPath(uint64_t segment) const {
+    return (fs::path(options_.directory) / ("quests-" + std::to_string(segment) + ".snap")).string();
+}
+
+bool QuestProgressStore::Open(const QuestStoreOptions& options) {
+    Close();
+    options_ = options;
+    std::error_code ec;
+    fs::create_directories(options_.directory, ec);
+    if (ec) return false;
+
+    std::vector<uint64_t> snapshots;
+    std::vector<uint64_t> segments;
+    for (const auto& entry : fs::directory_iterator(options_.directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        uint64_t seq = 0;
+        if (ParseSequence(name, ".snap", seq)) snapshots.push_back(seq);
+        else if (ParseSequence(name, ".wal", seq)) segments.push_back(seq);
+    }
+    if (ec) return false;
+    std::sort(snapshots.begin(), snapshots.end());
+    std::sort(segments.begin(), segments.end());
+
+    // No other thread runs yet; the locks keep the lock order uniform.
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Newest snapshot that validates; a torn one (crash mid-compaction) is
+    // skipped in favour of its predecessor, whose log is still on disk.
+    snapshotSegment_ = 0;
+    for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it) {
+        MappedFile file;
+        if (!file.Open(SnapshotPath(*it)) || !ValidSnapshot(file, *it)) continue;
+        snapshot_ = std::move(file);
+        snapshotSegment_ = *it;
+        break;
+    }
+
+    tail_.clear();
+    for (uint64_t seq : segments)
+        if (seq >= snapshotSegment_) ReplaySegment(SegmentPath(seq));
+    sinceCompact_ = 0;
+    for (const auto& [playerId, records] : tail_) sinceCompact_ += records.size();
+
+    // Appends go to a fresh segment; a torn frame at the end of the last one
+    // is simply never read past.
+    uint64_t next = snapshotSegment_;
+    if (!segments.empty()) next = std::max(next, segments.back() + 1);
+    if (!OpenSegment(next)) return false;
+    appended_ = durable_ = commits_ = compactions_ = 0;
+    stop_ = false;
+    committer_ = std::thread(&QuestProgressStore::CommitLoop, this);
+    if (options_.compactAfterRecords != 0) compactor_ = std::thread(&QuestProgressStore::CompactLoop, this);
+    return true;
+}
+
+void QuestProgressStore::Close() {
+    if (!committer_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    commitWake_.notify_one();
+    compactWake_.notify_one();
+    if (compactor_.joinable()) compactor_.join();
+    committer_.join();
+    CommitPending();
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+    if (wal_) std::fclose(wal_);
+    wal_ = nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_.Close();
+    tail_.clear();
+    folding_.reset();
+}
+
+bool QuestProgressStore::OpenSegment(uint64_t segment) {
+    if (wal_) std::fclose(wal_);
+    wal_ = std::fopen(SegmentPath(segment).c_str(), "wb");
+    segment_ = segment;
+    // The new name must be durable before any commit in it counts as such.
+    if (wal_ && !SyncDirectory(options_.directory)) {
+        std::fclose(wal_);
+        wal_ = nullptr;
+    }
+    return wal_ != nullptr;
+}
+
+void QuestProgressStore::ReplaySegment(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return;
+    std::error_code ec;
+    uint64_t remaining = fs::file_size(path, ec);
+    if (ec) remaining = 0;
+    std::vector<QuestLogRecord> frame;
+    FrameHeader header;
+    while (remaining >= sizeof(header) && std::fread(&header, sizeof(header), 1, file) == 1 &&
+           header.magic == kFrameMagic) {
+        remaining -= sizeof(header);
+        if (uint64_t{ header.count } * sizeof(QuestLogRecord) > remaining) break;  // torn frame
+        remaining -= uint64_t{ header.count } * sizeof(QuestLogRecord);
+        frame.resize(header.count);
+        if (std::fread(frame.data(), sizeof(QuestLogRecord), frame.size(), file) != frame.size()) break;
+        if (Crc32(frame.data(), frame.size() * sizeof(QuestLogRecord)) != header.crc) break;
+        for (const QuestLogRecord& rec : frame) tail_[rec.playerId].push_back(rec);
+    }
+    std::fclose(file);
+}
+
+void QuestProgressStore::Append(const QuestLogRecord& record) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(record);
+        tail_[record.playerId].push_back(record);
+        ++appended_;
+        ++sinceCompact_;
+        wake = pending_.size() >= options_.groupCommitRecords;
+    }
+    if (wake) commitWake_.notify_one();
+}
+
+// Writes writing_ as one frame and syncs it; on success everything appended
+// up to target is durable. On failure the batch goes back to the front of
+// pending_ and the log rolls to a fresh segment, so no later frame lands
+// behind torn bytes (replay stops at the first bad frame of a segment). A
+// frame that did reach the disk is then logged twice, which folds to the
+// same state since records set rather than add.
+bool QuestProgressStore::WriteBatch(uint64_t target) {
+    const bool wrote = !writing_.empty();
+    bool ok = wal_ != nullptr;
+    if (ok && wrote) {
+        const FrameHeader header{ kFrameMagic, static_cast<uint32_t>(writing_.size()),
+                                  Crc32(writing_.data(), writing_.size() * sizeof(QuestLogRecord)), 0 };
+        ok = std::fwrite(&header, sizeof(header), 1, wal_) == 1 &&
+             std::fwrite(writing_.data(), sizeof(QuestLogRecord), writing_.size(), wal_) == writing_.size();
+    }
+    ok = ok && SyncFile(wal_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ok) {
+            durable_ = std::max(durable_, target);
+            if (wrote) ++commits_;
+        } else {
+            pending_.insert(pending_.begin(), writing_.begin(), writing_.end());
+        }
+    }
+    writing_.clear();
+    if (!ok) OpenSegment(segment_ + 1);
+    return ok;
+}
+
+bool QuestProgressStore::CommitPending() {
+    std::lock_guard<std::mutex> writeLock(writeMutex_);
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) return true;
+        writing_.swap(pending_);
+        target = appended_;
+    }
+    return WriteBatch(target);
+}
+
+void QuestProgressStore::CommitLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        commitWake_.wait_for(lock, std::chrono::milliseconds(options_.groupCommitMs),
+                             [&] { return stop_ || pending_.size() >= options_.groupCommitRecords; });
+        if (pending_.empty()) continue;
+        lock.unlock();
+        CommitPending();
+        lock.lock();
+        if (options_.compactAfterRecords != 0 && sinceCompact_ >= options_.compactAfterRecords)
+            compactWake_.notify_one();
+    }
+}
+
+void QuestProgressStore::CompactLoop() {
+    // Runs beside the commit thread so group commits continue while the
+    // snapshot is written. After a failed compaction (already logged to the
+    // tail again), the next attempt waits for another threshold's worth.
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t due = options_.compactAfterRecords;
+    while (!stop_) {
+        compactWake_.wait(lock, [&] { return stop_ || sinceCompact_ >= due; });
+        if (stop_) break;
+        lock.unlock();
+        const bool ok = Compact();
+        lock.lock();
+        due = ok ? options_.compactAfterRecords : sinceCompact_ + options_.compactAfterRecords;
+    }
+}
+
+bool QuestProgressStore::Flush() {
+    return CommitPending();
+}
+
+Span<const QuestLogRecord> QuestProgressStore::SnapshotRecords(PlayerId playerId) const {
+    if (!snapshot_.IsOpen()) return {};
+    SnapshotHeader header;
+    std::memcpy(&header, snapshot_.Data(), sizeof(header));
+    const auto* index = reinterpret_cast<const SnapshotIndexEntry*>(snapshot_.Data() + header.indexOffset);
+    const auto* end = index + header.playerCount;
+    const auto* it = std::lower_bound(index, end, playerId,
+                                      [](const SnapshotIndexEntry& e, PlayerId id) { return e.playerId < id; });
+    if (it == end || it->playerId != playerId) return {};
+    const auto* records = reinterpret_cast<const QuestLogRecord*>(snapshot_.Data() + sizeof(SnapshotHeader));
+    return Span<const QuestLogRecord>(records + it->firstRecord, it->count);
+}
+
+bool QuestProgressStore::LoadPlayer(PlayerId playerId, std::vector<QuestLogRecord>& out) const {
+    std::vector<QuestLogRecord> merged;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Span<const QuestLogRecord> base = SnapshotRecords(playerId);
+        merged.assign(base.begin(), base.end());
+        if (folding_) {
+            auto it = folding_->find(playerId);
+            if (it != folding_->end()) merged.insert(merged.end(), it->second.begin(), it->second.end());
+        }
+        auto it = tail_.find(playerId);
+        if (it != tail_.end()) merged.insert(merged.end(), it->second.begin(), it->second.end());
+    }
+    std::vector<QuestFold> folds;
+    FoldRecords(merged, folds, out);
+    return !out.empty();
+}
+
+bool QuestProgressStore::WriteSnapshot(const std::string& path, uint64_t firstSegment, const RecordMap& tail) const {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    // The header goes in last, after the body is synced, so a torn file
+    // never validates.
+    SnapshotHeader header{};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // Merge the old snapshot's index (sorted) with the tail's players.
+    const SnapshotIndexEntry* oldIndex = nullptr;
+    const QuestLogRecord* oldRecords = nullptr;
+    size_t oldPlayers = 0;
+    if (snapshot_.IsOpen()) {
+        SnapshotHeader old;
+        std::memcpy(&old, snapshot_.Data(), sizeof(old));
+        oldIndex = reinterpret_cast<const SnapshotIndexEntry*>(snapshot_.Data() + old.indexOffset);
+        oldRecords = reinterpret_cast<const QuestLogRecord*>(snapshot_.Data() + sizeof(SnapshotHeader));
+        oldPlayers = static_cast<size_t>(old.playerCount);
+    }
+    std::vector<PlayerId> tailPlayers;
+    tailPlayers.reserve(tail.size());
+    for (const auto& [playerId, records] : tail) tailPlayers.push_back(playerId);
+    std::sort(tailPlayers.begin(), tailPlayers.end());
+
+    std::vector<SnapshotIndexEntry> index;
+    index.reserve(oldPlayers + tailPlayers.size());
+    std::vector<QuestLogRecord> merged;
+    std::vector<QuestLogRecord> folded;
+    std::vector<QuestFold> folds;
+    uint64_t recordCount = 0;
+    auto emit = [&](PlayerId playerId, const QuestLogRecord* records, size_t count) {
+        if (count == 0) return;
+        index.push_back(SnapshotIndexEntry{ playerId, static_cast<uint32_t>(count), recordCount });
+        for (size_t done = 0; done < count && ok; done += kCopyChunk) {
+            const size_t n = std::min(kCopyChunk, count - done);
+            ok = std::fwrite(records + done, sizeof(QuestLogRecord), n, file) == n;
+            header.crc = Crc32(records + done, n * sizeof(QuestLogRecord), header.crc);
+        }
+        recordCount += count;
+    };
+
+    size_t o = 0;
+    size_t t = 0;
+    while (ok && (o < oldPlayers || t < tailPlayers.size())) {
+        const bool takeOld = t == tailPlayers.size() || (o < oldPlayers && oldIndex[o].playerId <= tailPlayers[t]);
+        const bool takeTail = o == oldPlayers || (t < tailPlayers.size() && tailPlayers[t] <= oldIndex[o].playerId);
+        if (takeOld && !takeTail) {
+            emit(oldIndex[o].playerId, oldRecords + oldIndex[o].firstRecord, oldIndex[o].count);  // already minimal
+            ++o;
+            continue;
+        }
+        const PlayerId playerId = tailPlayers[t];
+        merged.clear();
+        if (takeOld) {
+            merged.assign(oldRecords + oldIndex[o].firstRecord, oldRecords + oldIndex[o].firstRecord + oldIndex[o].count);
+            ++o;
+        }
+        const auto& records = tail.at(playerId);
+        merged.insert(merged.end(), records.begin(), records.end());
+        FoldRecords(merged, folds, folded);
+        emit(playerId, folded.data(), folded.size());
+        ++t;
+    }
+
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.firstSegment = firstSegment;
+    header.playerCount = index.size();
+    header.recordCount = recordCount;
+    header.indexOffset = IndexOffset(recordCount);
+    static const char kZeros[alignof(SnapshotIndexEntry)] = {};
+    const size_t pad = static_cast<size_t>(header.indexOffset - (sizeof(SnapshotHeader) + recordCount * sizeof(QuestLogRecord)));
+    ok = ok && (pad == 0 || std::fwrite(kZeros, 1, pad, file) == pad);
+    ok = ok && std::fwrite(index.data(), sizeof(SnapshotIndexEntry), index.size(), file) == index.size();
+    header.crc = Crc32(kZeros, pad, header.crc);
+    header.crc = Crc32(index.data(), index.size() * sizeof(SnapshotIndexEntry), header.crc);
+    ok = ok && SyncFile(file) && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && SyncFile(file);
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool QuestProgressStore::Compact() {
+    if (!IsOpen()) return false;
+    std::lock_guard<std::mutex> compactLock(compactMutex_);
+
+    // Seal the open segment: everything appended so far goes into it and
+    // moves from tail_ to folding_; later appends land in the next segment.
+    uint64_t firstSegment = 0;
+    std::shared_ptr<const RecordMap> folding;
+    {
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        uint64_t target = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writing_.swap(pending_);
+            target = appended_;
+            folding = std::make_shared<const RecordMap>(std::move(tail_));
+            tail_ = RecordMap();
+            sinceCompact_ = 0;
+            folding_ = folding;
+        }
+        bool ok = WriteBatch(target);
+        firstSegment = segment_ + 1;
+        ok = ok && OpenSegment(firstSegment);
+        if (!ok) {
+            RestoreFolding(*folding);
+            return false;
+        }
+    }
+
+    // The snapshot is only replaced by this thread, so it can be read here
+    // without mutex_.
+    const std::string path = SnapshotPath(firstSegment);
+    // The directory is synced before the covered segments are removed.
+    const bool written = WriteSnapshot(path, firstSegment, *folding) && SyncDirectory(options_.directory);
+    MappedFile mapped;
+    if (!written || !mapped.Open(path)) {
+        // Keep serving from the old snapshot plus the folding tail, which is
+        // still on disk in the sealed segments.
+        RestoreFolding(*folding);
+        std::error_code ec;
+        fs::remove(path, ec);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_ = std::move(mapped);  // unmaps the previous snapshot
+        snapshotSegment_ = firstSegment;
+        folding_.reset();
+        ++compactions_;
+    }
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(options_.directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        uint64_t seq = 0;
+        if ((ParseSequence(name, ".wal", seq) || ParseSequence(name, ".snap", seq)) && seq < firstSegment)
+            fs::remove(entry.path(), ec);
+    }
+    return true;
+}
+
+void QuestProgressStore::RestoreFolding(const RecordMap& folding) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [playerId, records] : folding) {
+        auto& dst = tail_[playerId];
+        dst.insert(dst.begin(), records.begin(), records.end());
+        sinceCompact_ += records.size();
+    }
+    folding_.reset();
+}
+
+QuestStoreStats QuestProgressStore::Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QuestStoreStats stats;
+    stats.appended = appended_;
+    stats.durable = durable_;
+    stats.commits = commits_;
+    stats.compactions = compactions_;
+    if (snapshot_.IsOpen()) {
+        SnapshotHeader header;
+        std::memcpy(&header, snapshot_.Data(), sizeof(header));
+        stats.snapshotPlayers = header.playerCount;
+    }
+    stats.tailPlayers = tail_.size();
+    return stats;
+}
+
+} // namespace game
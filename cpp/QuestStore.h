@@ -0,0 +1,138 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "MappedFile.h"
+#include "Quest.h"
+#include "Span.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+struct QuestStoreOptions {
+    std::string directory;
+    uint32_t groupCommitMs = 10;        // longest an appended record waits for its fsync
+    size_t groupCommitRecords = 65536;  // commit early once this many are pending
+    // Compact in the background once this many records are logged past the
+    // snapshot (about 20 bytes each on disk); 0 leaves compaction to the caller.
+    uint64_t compactAfterRecords = uint64_t{ 1 } << 22;
+};
+
+struct QuestStoreStats {
+    uint64_t appended = 0;   // records appended since Open
+    uint64_t durable = 0;    // of those, records on stable storage
+    uint64_t commits = 0;    // group commits (one write + fsync each)
+    uint64_t compactions = 0;  // snapshots written since Open
+    uint64_t snapshotPlayers = 0;
+    uint64_t tailPlayers = 0;  // players with log records newer than the snapshot
+};
+
+// ---------------------------------------------------------------------------
+// Durable per-player quest progress. QuestSystem mutations (QuestLogRecord,
+// via SetPersistCallback) are appended to an in-memory batch; a background
+// thread writes each batch as one checksummed frame of the write-ahead log
+// and fsyncs it, so durability costs one disk sync per commit interval
+// rather than per event.
+//
+// Compact folds the log into a new snapshot: every player's minimal record
+// list, sorted by player with an index, read through a memory map. Open maps
+// the newest snapshot whose checksum and index validate (one sequential pass;
+// a damaged one falls back to its predecessor) and replays only the log
+// segments written after it, so recovery time follows the log tail. LoadPlayer folds
+// a player's snapshot records and newer log records on demand (on connect).
+// The store owns compaction: the commit thread wakes a compaction thread once
+// compactAfterRecords records have been logged since the last snapshot, so
+// the log and recovery time stay bounded without a caller-side schedule.
+// Compact can still be called directly (e.g. before a planned shutdown).
+//
+// Files in the directory: quests-<n>.snap (snapshot covering log segments
+// below n) and quests-<n>.wal (log segment n). Records are stored in host
+// byte order.
+// ---------------------------------------------------------------------------
+class QuestProgressStore {
+public:
+    QuestProgressStore() = default;
+    ~QuestProgressStore() { Close(); }
+
+    QuestProgressStore(const QuestProgressStore&) = delete;
+    QuestProgressStore& operator=(const QuestProgressStore&) = delete;
+
+    // Creates the directory if needed, recovers the newest snapshot and the
+    // log after it and starts the commit (and compaction) thread. False on
+    // I/O failure.
+    bool Open(const QuestStoreOptions& options);
+    // Commits everything appended and stops the background threads.
+    void Close();
+    bool IsOpen() const { return committer_.joinable(); }
+
+    // Thread-safe; no I/O. Records for one player must be appended in order.
+    void Append(const QuestLogRecord& record);
+    // Blocks until every record appended before the call is durable; false
+    // if the write failed (the records stay queued and are retried in a
+    // fresh log segment by the next commit).
+    bool Flush();
+
+    // The player's folded state (the records RestorePlayer needs); false if
+    // nothing is stored for them. Thread-safe.
+    bool LoadPlayer(PlayerId playerId, std::vector<QuestLogRecord>& out) const;
+
+    // Writes a new snapshot from the previous one plus the log, then drops
+    // the log segments it covers. Appends and loads continue meanwhile;
+    // compactions do not overlap.
+    bool Compact();
+
+    QuestStoreStats Stats() const;
+
+private:
+    using RecordMap = std::unordered_map<PlayerId, std::vector<QuestLogRecord>>;
+
+    std::string SegmentPath(uint64_t segment) const;
+    std::string SnapshotPath(uint64_t segment) const;
+    bool OpenSegment(uint64_t segment);
+    void ReplaySegment(const std::string& path);
+    Span<const QuestLogRecord> SnapshotRecords(PlayerId playerId) const;
+    bool WriteSnapshot(const std::string& path, uint64_t firstSegment, const RecordMap& tail) const;
+    bool WriteBatch(uint64_t target);  // writeMutex_ held
+    bool CommitPending();
+    void RestoreFolding(const RecordMap& folding);
+    void CommitLoop();
+    void CompactLoop();
+
+    QuestStoreOptions options_;
+
+    // Guarded by mutex_.
+    mutable std::mutex mutex_;
+    std::vector<QuestLogRecord> pending_;  // appended, not yet written
+    RecordMap tail_;                        // log records newer than the snapshot
+    std::shared_ptr<const RecordMap> folding_;  // tail being compacted
+    MappedFile snapshot_;
+    uint64_t snapshotSegment_ = 0;  // first log segment the snapshot does not cover
+    uint64_t appended_ = 0;
+    uint64_t durable_ = 0;
+    uint64_t commits_ = 0;
+    uint64_t compactions_ = 0;
+    uint64_t sinceCompact_ = 0;  // records in tail_
+    bool stop_ = false;
+    std::condition_variable commitWake_;
+    std::condition_variable compactWake_;
+
+    // Guarded by writeMutex_ (taken before mutex_): the open segment, and the
+    // swap-then-write of each commit so batches reach the log in order.
+    std::mutex writeMutex_;
+    std::FILE* wal_ = nullptr;
+    uint64_t segment_ = 0;
+    std::vector<QuestLogRecord> writing_;
+
+    std::mutex compactMutex_;
+    std::thread committer_;
+    std::thread compactor_;
+};
+
+} // namespace game
@@ -0,0 +1,10 @@
+#pragma once
+
+// SSE2 kernels are compiled when the target guarantees SSE2 (x86-64, or
+// 32-bit x86 built with it); every kernel keeps a scalar path for the rest.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GAME_SIMD_SSE2 1
+#else
+#define GAME_SIMD_SSE2 0
+#endif
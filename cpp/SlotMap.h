@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Span.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Generational handles over dense storage: 32-bit handle = [generation:12]
+// [slot index:20]. Erasing bumps the slot's generation, so stale handles stop
+// resolving. Handle 0 is never issued.
+//
+// SlotIndex only does the handle <-> dense index bookkeeping, so callers can
+// keep their values in one array (SlotMap) or in parallel columns; on Erase
+// the caller moves its last dense element into the freed position.
+// ---------------------------------------------------------------------------
+class SlotIndex {
+public:
+    using Handle = uint32_t;
+
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (1u << (32 - kIndexBits)) - 1;
+    static constexpr size_t kMaxSlots = kIndexMask + 1;
+
+    void Reserve(size_t capacity) {
+        if (capacity > kMaxSlots) capacity = kMaxSlots;
+        denseToSlot_.reserve(capacity);
+        slots_.reserve(capacity);
+        freeList_.reserve(capacity);
+    }
+
+    // Claims dense index Size(); returns 0 when every slot is in use.
+    Handle Insert() {
+        uint32_t slot;
+        if (!freeList_.empty()) {
+            slot = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            if (slots_.size() >= kMaxSlots) return 0;
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+        slots_[slot].dense = static_cast<uint32_t>(denseToSlot_.size());
+        denseToSlot_.push_back(slot);
+        return MakeHandle(slot, slots_[slot].generation);
+    }
+
+    // Frees a live handle. Returns its dense index; the caller moves its
+    // element at Size() (the old last index) there and pops the back.
+    int64_t Erase(Handle h) {
+        if (!IsLive(h)) return -1;
+        uint32_t slot = h & kIndexMask;
+        uint32_t dense = slots_[slot].dense;
+        uint32_t last = static_cast<uint32_t>(denseToSlot_.size() - 1);
+        if (dense != last) {
+            denseToSlot_[dense] = denseToSlot_[last];
+            slots_[denseToSlot_[dense]].dense = dense;
+        }
+        denseToSlot_.pop_back();
+        Retire(slot);
+        return dense;
+    }
+
+    void Clear() {
+        for (uint32_t slot : denseToSlot_)
+            Retire(slot);
+        denseToSlot_.clear();
+    }
+
+    bool Contains(Handle h) const { return IsLive(h); }
+
+    // Dense index of a live handle (or -1); stable until the next Erase.
+    int64_t IndexOf(Handle h) const { return IsLive(h) ? static_cast<int64_t>(slots_[h & kIndexMask].dense) : -1; }
+    Handle HandleAt(size_t denseIndex) const {
+        uint32_t slot = denseToSlot_[denseIndex];
+        return MakeHandle(slot, slots_[slot].generation);
+    }
+
+    size_t Size() const { return denseToSlot_.size(); }
+    size_t Capacity() const { return denseToSlot_.capacity(); }
+    bool Empty() const { return denseToSlot_.empty(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;
+        uint32_t generation = 1;  // never 0, so handle 0 stays invalid
+    };
+
+    static Handle MakeHandle(uint32_t slot, uint32_t generation) {
+        return (generation << kIndexBits) | slot;
+    }
+
+    bool IsLive(Handle h) const {
+        uint32_t slot = h & kIndexMask;
+        if (h == 0 || slot >= slots_.size()) return false;
+        const Slot& s = slots_[slot];
+        return s.generation == (h >> kIndexBits) && s.dense < denseToSlot_.size() && denseToSlot_[s.dense] == slot;
+    }
+
+    void Retire(uint32_t slot) {
+        uint32_t gen = (slots_[slot].generation + 1) & kGenerationMask;
+        slots_[slot].generation = gen == 0 ? 1 : gen;
+        freeList_.push_back(slot);
+    }
+
+    std::vector<uint32_t> denseToSlot_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeList_;
+};
+
+// Slot map with values stored densely (swap-remove on erase). Insert/Erase do
+// not allocate while Size() < Capacity().
+template <typename T>
+class SlotMap {
+public:
+    using Handle = SlotIndex::Handle;
+
+    void Reserve(size_t capacity) {
+        index_.Reserve(capacity);
+        dense_.reserve(capacity < SlotIndex::kMaxSlots ? capacity : SlotIndex::kMaxSlots);
+    }
+
+    Handle Insert(T value) {
+        Handle h = index_.Insert();
+        if (h != 0) dense_.push_back(std::move(value));
+        return h;
+    }
+
+    bool Erase(Handle h) {
+        int64_t dense = index_.Erase(h);
+        if (dense < 0) return false;
+        if (static_cast<size_t>(dense) != dense_.size() - 1)
+            dense_[static_cast<size_t>(dense)] = std::move(dense_.back());
+        dense_.pop_back();
+        return true;
+    }
+
+    void Clear() {
+        index_.Clear();
+        dense_.clear();
+    }
+
+    T* Get(Handle h) {
+        int64_t i = index_.IndexOf(h);
+        return i >= 0 ? &dense_[static_cast<size_t>(i)] : nullptr;
+    }
+    const T* Get(Handle h) const {
+        int64_t i = index_.IndexOf(h);
+        return i >= 0 ? &dense_[static_cast<size_t>(i)] : nullptr;
+    }
+    bool Contains(Handle h) const { return index_.Contains(h); }
+
+    int64_t IndexOf(Handle h) const { return index_.IndexOf(h); }
+    Handle HandleAt(size_t denseIndex) const { return index_.HandleAt(denseIndex); }
+
+    size_t Size() const { return dense_.size(); }
+    size_t Capacity() const { return dense_.capacity(); }
+    bool Empty() const { return dense_.empty(); }
+
+    Span<T> Values() { return Span<T>(dense_.data(), dense_.size()); }
+    Span<const T> Values() const { return Span<const T>(dense_.data(), dense_.size()); }
+
+private:
+    SlotIndex index_;
+    std::vector<T> dense_;
+};
+
+} // namespace game
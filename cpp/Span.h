@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Minimal non-owning view over contiguous elements (C++17 has no std::span).
+// ---------------------------------------------------------------------------
+template <typename T>
+class Span {
+public:
+    constexpr Span() = default;
+    constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    template <size_t N>
+    constexpr Span(T (&arr)[N]) : data_(arr), size_(N) {}
+
+    template <typename Container,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Container>, Span> &&
+                                          std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container& c) : data_(c.data()), size_(c.size()) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T& operator[](size_t i) const { return data_[i]; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace game
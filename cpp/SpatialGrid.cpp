@@ -0,0 +1,159 @@
+#include "SpatialGrid.h"
+#include "Simd.h"
+#include <algorithm>
+#include <climits>
+
+namespace game {
+
+namespace {
+
+constexpr uint32_t kMinBuckets = 64;
+
+} // namespace
+
+void SpatialGrid::Build(Span<const uint32_t> ids, Span<const float> xs, Span<const float> ys, Span<const float> zs) {
+    const size_t n = ids.size();
+
+    itemCx_.resize(n);
+    itemCz_.resize(n);
+    minCx_ = minCz_ = INT32_MAX;
+    maxCx_ = maxCz_ = INT32_MIN;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t cx = CellCoord(xs[i]);
+        int32_t cz = CellCoord(zs[i]);
+        itemCx_[i] = cx;
+        itemCz_[i] = cz;
+        minCx_ = std::min(minCx_, cx);
+        maxCx_ = std::max(maxCx_, cx);
+        minCz_ = std::min(minCz_, cz);
+        maxCz_ = std::max(maxCz_, cz);
+    }
+    if (n == 0) {
+        minCx_ = minCz_ = 0;
+        maxCx_ = maxCz_ = -1;
+    }
+
+    // Dense indexing while the bounding box has at most ~4 cells per item;
+    // hashing (~2 buckets per item) for sparse, spread-out sets.
+    uint64_t boxCells = n == 0 ? 0
+        : static_cast<uint64_t>(static_cast<int64_t>(maxCx_) - minCx_ + 1) *
+          static_cast<uint64_t>(static_cast<int64_t>(maxCz_) - minCz_ + 1);
+    dense_ = n > 0 && boxCells <= 4 * static_cast<uint64_t>(n) + kMinBuckets;
+    if (dense_) {
+        width_ = static_cast<uint32_t>(maxCx_ - minCx_ + 1);
+        bucketCount_ = static_cast<uint32_t>(boxCells);
+    } else {
+        bucketCount_ = kMinBuckets;
+        while (bucketCount_ < 2 * n) bucketCount_ <<= 1;
+    }
+    bucketStart_.assign(static_cast<size_t>(bucketCount_) + 1, 0u);
+
+    itemBucket_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t b = BucketOf(itemCx_[i], itemCz_[i]);
+        itemBucket_[i] = b;
+        bucketStart_[b + 1]++;
+    }
+    for (size_t b = 1; b < bucketStart_.size(); ++b)
+        bucketStart_[b] += bucketStart_[b - 1];
+
+    ids_.resize(n);
+    cells_.resize(n);
+    xs_.resize(n);
+    ys_.resize(n);
+    zs_.resize(n);
+    // Place each item at its bucket's cursor; bucketStart_[b] ends up at the
+    // start of bucket b + 1, so shift back afterwards.
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t slot = bucketStart_[itemBucket_[i]]++;
+        ids_[slot] = ids[i];
+        cells_[slot] = CellKey(itemCx_[i], itemCz_[i]);
+        xs_[slot] = xs[i];
+        ys_[slot] = ys[i];
+        zs_[slot] = zs[i];
+    }
+    for (size_t b = bucketStart_.size() - 1; b > 0; --b)
+        bucketStart_[b] = bucketStart_[b - 1];
+    bucketStart_[0] = 0;
+}
+
+void SpatialGrid::QueryRadius(const Vec3& p, float radius, std::vector<uint32_t>& out) const {
+    ForEachInRadius(p, radius, [&](uint32_t id, float, float, float) {
+        out.push_back(id);
+        return true;
+    });
+}
+
+size_t SpatialGrid::GatherInRadius(const Vec3& p, float radius, uint32_t skip, size_t maxCount,
+                                   uint32_t* outIds, float* outX, float* outZ) const {
+    maxCount = std::min(maxCount, kMaxGather);
+    if (ids_.empty() || !(radius >= 0.0f) || !std::isfinite(radius) || !IsFinite(p) || maxCount == 0) return 0;
+    const float r2 = radius * radius;
+
+    // Entry indices of the hits so far. Every candidate is written and the
+    // count only advances on a hit, so no branch depends on the (random)
+    // distance test; the slack covers one group written past maxCount.
+    uint32_t hits[kMaxGather + 4];
+    size_t count = 0;
+    auto keep = [&](uint32_t e, uint32_t inRadius, bool checkKey, uint64_t key) {
+        hits[count] = e;
+        count += inRadius & static_cast<uint32_t>(ids_[e] != skip) & static_cast<uint32_t>(!checkKey || cells_[e] == key);
+    };
+    // Scans [begin, end) (only entries of cell `key` when checkKey); false
+    // once maxCount are kept.
+    auto scan = [&](uint32_t begin, uint32_t end, bool checkKey, uint64_t key) {
+        uint32_t e = begin;
+#if GAME_SIMD_SSE2
+        const __m128 px = _mm_set1_ps(p.x), py = _mm_set1_ps(p.y), pz = _mm_set1_ps(p.z);
+        const __m128 vr2 = _mm_set1_ps(r2);
+        for (; e + 4 <= end; e += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs_.data() + e), px);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys_.data() + e), py);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(zs_.data() + e), pz);
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            const uint32_t in = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpngt_ps(d2, vr2)));  // as the scalar test
+            for (uint32_t k = 0; k < 4; ++k) keep(e + k, (in >> k) & 1u, checkKey, key);
+            if (count >= maxCount) return false;
+        }
+#endif
+        for (; e < end; ++e) {
+            float dx = xs_[e] - p.x, dy = ys_[e] - p.y, dz = zs_[e] - p.z;
+            keep(e, static_cast<uint32_t>(!(dx * dx + dy * dy + dz * dz > r2)), checkKey, key);
+            if (count >= maxCount) return false;
+        }
+        return true;
+    };
+    auto emit = [&] {
+        count = std::min(count, maxCount);
+        for (size_t i = 0; i < count; ++i) {
+            outIds[i] = ids_[hits[i]];
+            outX[i] = xs_[hits[i]];
+            outZ[i] = zs_[hits[i]];
+        }
+        return count;
+    };
+
+    // Same cell walk as ForEachInRadius.
+    const int32_t cx0 = std::max(CellCoord(p.x - radius), minCx_), cx1 = std::min(CellCoord(p.x + radius), maxCx_);
+    const int32_t cz0 = std::max(CellCoord(p.z - radius), minCz_), cz1 = std::min(CellCoord(p.z + radius), maxCz_);
+    if (cx0 > cx1 || cz0 > cz1) return 0;
+    const uint64_t cellCount = static_cast<uint64_t>(cx1 - cx0 + 1) * static_cast<uint64_t>(cz1 - cz0 + 1);
+    if (cellCount > bucketCount_) {
+        scan(0, static_cast<uint32_t>(ids_.size()), false, 0);
+        return emit();
+    }
+    if (dense_) {
+        for (int32_t cz = cz0; cz <= cz1; ++cz)
+            if (!scan(bucketStart_[BucketOf(cx0, cz)], bucketStart_[BucketOf(cx1, cz) + 1], false, 0)) break;
+        return emit();
+    }
+    for (int32_t cz = cz0; cz <= cz1; ++cz) {
+        for (int32_t cx = cx0; cx <= cx1; ++cx) {
+            const uint32_t b = BucketOf(cx, cz);
+            if (!scan(bucketStart_[b], bucketStart_[b + 1], true, CellKey(cx, cz))) return emit();
+        }
+    }
+    return emit();
+}
+
+} // namespace game
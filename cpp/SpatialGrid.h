@@ -0,0 +1,138 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "Span.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Uniform spatial grid over the horizontal (x, z) plane. Build() buckets a
+// snapshot of ids + positions with a counting sort (no allocation once the
+// buffers have grown); radius queries visit only the cells the query circle
+// overlaps, so cost follows local density rather than total count. Distance
+// tests are full 3D.
+//
+// When the occupied cells' bounding box is small relative to the item count
+// the cells are indexed densely (row-major over the box, so neighbouring
+// cells are neighbours in memory); otherwise they are hashed into ~2 buckets
+// per item.
+// ---------------------------------------------------------------------------
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 4.0f) : cellSize_(cellSize), invCellSize_(1.0f / cellSize) {}
+
+    float CellSize() const { return cellSize_; }
+    size_t Size() const { return ids_.size(); }
+
+    void Build(Span<const uint32_t> ids, Span<const float> xs, Span<const float> ys, Span<const float> zs);
+
+    // Ids in bucket order: iterating in this order keeps consecutive queries
+    // on neighbouring cells.
+    Span<const uint32_t> SortedIds() const { return ids_; }
+
+    // Queries with a non-finite position or a negative or non-finite radius
+    // find nothing.
+
+    // Appends the ids within radius of p (inclusive) to out.
+    void QueryRadius(const Vec3& p, float radius, std::vector<uint32_t>& out) const;
+
+    // Calls fn(id, x, y, z) for every entry within radius of p (inclusive)
+    // until fn returns false.
+    template <typename Fn>
+    void ForEachInRadius(const Vec3& p, float radius, Fn&& fn) const;
+
+    // The first maxCount (at most kMaxGather) entries ForEachInRadius would
+    // visit, skipping id `skip`: writes their ids and x/z positions and
+    // returns how many. Distance tests run four entries at a time (SSE2)
+    // and hits are kept without branching on them.
+    static constexpr size_t kMaxGather = 64;
+    size_t GatherInRadius(const Vec3& p, float radius, uint32_t skip, size_t maxCount,
+                          uint32_t* outIds, float* outX, float* outZ) const;
+
+private:
+    static constexpr float kMaxCellCoord = 536870912.0f;  // 2^29 cells each way
+
+    int32_t CellCoord(float v) const {
+        // floor without the libm call (std::floor is not inlined below SSE4.1).
+        // Clamped first so the cast is defined and cell differences fit
+        // int32_t; NaN lands on the low bound.
+        float s = v * invCellSize_;
+        if (!(s > -kMaxCellCoord)) s = -kMaxCellCoord;
+        if (!(s < kMaxCellCoord)) s = kMaxCellCoord;
+        int32_t c = static_cast<int32_t>(s);
+        return c - (s < static_cast<float>(c) ? 1 : 0);
+    }
+    uint32_t BucketOf(int32_t cx, int32_t cz) const {
+        if (dense_)
+            return static_cast<uint32_t>(cz - minCz_) * width_ + static_cast<uint32_t>(cx - minCx_);
+        uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cz) * 19349663u;
+        return h & (bucketCount_ - 1);
+    }
+    static uint64_t CellKey(int32_t cx, int32_t cz) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cz);
+    }
+
+    float cellSize_;
+    float invCellSize_;
+    bool dense_ = false;
+    int32_t minCx_ = 0, minCz_ = 0, maxCx_ = -1, maxCz_ = -1;  // occupied cell bounds
+    uint32_t width_ = 0;
+    uint32_t bucketCount_ = 0;
+    std::vector<uint32_t> bucketStart_;  // bucketCount_ + 1 entries
+    std::vector<int32_t> itemCx_;        // Build scratch
+    std::vector<int32_t> itemCz_;
+    std::vector<uint32_t> itemBucket_;
+
+    // Entries sorted by bucket. Hashed buckets can hold several cells, so
+    // each entry keeps its cell key.
+    std::vector<uint32_t> ids_;
+    std::vector<uint64_t> cells_;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<float> zs_;
+};
+
+template <typename Fn>
+void SpatialGrid::ForEachInRadius(const Vec3& p, float radius, Fn&& fn) const {
+    if (ids_.empty() || !(radius >= 0.0f) || !std::isfinite(radius) || !IsFinite(p)) return;
+    const float r2 = radius * radius;
+    auto visit = [&](size_t e) {
+        float dx = xs_[e] - p.x, dy = ys_[e] - p.y, dz = zs_[e] - p.z;
+        return dx * dx + dy * dy + dz * dz > r2 || fn(ids_[e], xs_[e], ys_[e], zs_[e]);
+    };
+
+    // Nothing lives outside the occupied bounds, so clamp the cell range.
+    const int32_t cx0 = std::max(CellCoord(p.x - radius), minCx_), cx1 = std::min(CellCoord(p.x + radius), maxCx_);
+    const int32_t cz0 = std::max(CellCoord(p.z - radius), minCz_), cz1 = std::min(CellCoord(p.z + radius), maxCz_);
+    if (cx0 > cx1 || cz0 > cz1) return;
+    const uint64_t cellCount = static_cast<uint64_t>(cx1 - cx0 + 1) * static_cast<uint64_t>(cz1 - cz0 + 1);
+    if (cellCount > bucketCount_) {
+        // Query covers more cells than there are buckets: a flat scan is cheaper.
+        for (size_t e = 0; e < ids_.size(); ++e)
+            if (!visit(e)) return;
+        return;
+    }
+
+    if (dense_) {
+        // Cells cx0..cx1 of one row are adjacent buckets: one entry range.
+        for (int32_t cz = cz0; cz <= cz1; ++cz) {
+            uint32_t end = bucketStart_[BucketOf(cx1, cz) + 1];
+            for (uint32_t e = bucketStart_[BucketOf(cx0, cz)]; e < end; ++e)
+                if (!visit(e)) return;
+        }
+        return;
+    }
+    for (int32_t cz = cz0; cz <= cz1; ++cz) {
+        for (int32_t cx = cx0; cx <= cx1; ++cx) {
+            uint32_t b = BucketOf(cx, cz);
+            uint64_t key = CellKey(cx, cz);
+            for (uint32_t e = bucketStart_[b]; e < bucketStart_[b + 1]; ++e)
+                if (cells_[e] == key && !visit(e)) return;
+        }
+    }
+}
+
+} // namespace game
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Bounded single-producer / single-consumer ring. Exactly one thread may
+// push and one (possibly different) thread may pop; neither side locks or
+// allocates. Capacity is rounded up to a power of two.
+//
+// Each side's index sits on its own cache line next to a cached copy of the
+// other side's index, so the shared line is only re-read when the ring looks
+// full (producer) or empty (consumer).
+// ---------------------------------------------------------------------------
+template <typename T>
+class SpscRing {
+public:
+    SpscRing() = default;
+    explicit SpscRing(size_t capacity) { Init(capacity); }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Not thread-safe: call before either side starts.
+    void Init(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        ring_.slots = std::make_unique<T[]>(cap);
+        ring_.mask = cap - 1;
+        producer_.tail.store(0, std::memory_order_relaxed);
+        producer_.cachedHead = 0;
+        consumer_.head.store(0, std::memory_order_relaxed);
+        consumer_.cachedTail = 0;
+    }
+
+    size_t Capacity() const { return ring_.slots ? ring_.mask + 1 : 0; }
+
+    // Producer side. Returns false when the ring is full.
+    bool TryPush(const T& value) {
+        if (!ring_.slots) return false;
+        const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if (tail - producer_.cachedHead > ring_.mask) {
+            producer_.cachedHead = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.cachedHead > ring_.mask) return false;
+        }
+        ring_.slots[tail & ring_.mask] = value;
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Calls fn(const T&) for everything pushed so far, in
+    // order, then frees those slots; returns how many.
+    template <typename Fn>
+    size_t PopAll(Fn&& fn) {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if (consumer_.cachedTail == head) {
+            consumer_.cachedTail = producer_.tail.load(std::memory_order_acquire);
+            if (consumer_.cachedTail == head) return 0;
+        }
+        const size_t tail = consumer_.cachedTail;
+        for (size_t i = head; i != tail; ++i) fn(static_cast<const T&>(ring_.slots[i & ring_.mask]));
+        consumer_.head.store(tail, std::memory_order_release);
+        return tail - head;
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+    struct ProducerSide {
+        std::atomic<size_t> tail{ 0 };  // next slot to push
+        size_t cachedHead = 0;
+        char pad[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    };
+    struct ConsumerSide {
+        std::atomic<size_t> head{ 0 };  // next slot to pop
+        size_t cachedTail = 0;
+        char pad[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    };
+
+    struct Storage {  // read-only once initialised
+        std::unique_ptr<T[]> slots;
+        size_t mask = 0;
+        char pad[kCacheLine - sizeof(std::unique_ptr<T[]>) - sizeof(size_t)];
+    };
+
+    Storage ring_;
+    ProducerSide producer_;
+    ConsumerSide consumer_;
+};
+
+} // namespace game
@@ -0,0 +1,195 @@
+#include "Steering.h"
+#include "Simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace game {
+
+namespace {
+
+constexpr float kEpsilon = 1e-8f;
+
+// Shared body of SteerSeek/SteerArrive; dist is only read when kArrive.
+template <bool kArrive>
+void SteerTowards(const SteeringParams& params, float dt,
+                  Span<const float> dirX, Span<const float> dirZ, Span<const float> dist,
+                  Span<const float> maxSpeed, Span<float> velX, Span<float> velZ) {
+    const size_t n = velX.size();
+    const float maxDelta = params.maxAccel * dt;
+    const float stop = params.stopRadius;
+    const float invRange = 1.0f / std::max(params.slowRadius - params.stopRadius, 1e-4f);
+    size_t i = 0;
+#if GAME_SIMD_SSE2
+    const __m128 vMaxDelta = _mm_set1_ps(maxDelta);
+    const __m128 vEps = _mm_set1_ps(kEpsilon);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vStop = _mm_set1_ps(stop);
+    const __m128 vInvRange = _mm_set1_ps(invRange);
+    for (; i + 4 <= n; i += 4) {
+        __m128 speed = _mm_loadu_ps(maxSpeed.data() + i);
+        if (kArrive) {
+            __m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(dist.data() + i), vStop), vInvRange);
+            speed = _mm_mul_ps(speed, _mm_min_ps(_mm_max_ps(t, vZero), vOne));
+        }
+        __m128 vx = _mm_loadu_ps(velX.data() + i);
+        __m128 vz = _mm_loadu_ps(velZ.data() + i);
+        __m128 sx = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(dirX.data() + i), speed), vx);
+        __m128 sz = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(dirZ.data() + i), speed), vz);
+        __m128 len = _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sz, sz)), vEps));
+        __m128 scale = _mm_min_ps(vOne, _mm_div_ps(vMaxDelta, len));
+        _mm_storeu_ps(velX.data() + i, _mm_add_ps(vx, _mm_mul_ps(sx, scale)));
+        _mm_storeu_ps(velZ.data() + i, _mm_add_ps(vz, _mm_mul_ps(sz, scale)));
+    }
+#endif
+    for (; i < n; ++i) {
+        float speed = maxSpeed[i];
+        if (kArrive)
+            speed *= std::min(std::max((dist[i] - stop) * invRange, 0.0f), 1.0f);
+        float sx = dirX[i] * speed - velX[i];
+        float sz = dirZ[i] * speed - velZ[i];
+        float len = std::sqrt(std::max(sx * sx + sz * sz, kEpsilon));
+        float scale = std::min(1.0f, maxDelta / len);
+        velX[i] += sx * scale;
+        velZ[i] += sz * scale;
+    }
+}
+
+} // namespace
+
+void SteerSeek(const SteeringParams& params, float dt,
+               Span<const float> dirX, Span<const float> dirZ, Span<const float> maxSpeed,
+               Span<float> velX, Span<float> velZ) {
+    SteerTowards<false>(params, dt, dirX, dirZ, Span<const float>(), maxSpeed, velX, velZ);
+}
+
+void SteerArrive(const SteeringParams& params, float dt,
+                 Span<const float> dirX, Span<const float> dirZ, Span<const float> dist,
+                 Span<const float> maxSpeed, Span<float> velX, Span<float> velZ) {
+    SteerTowards<true>(params, dt, dirX, dirZ, dist, maxSpeed, velX, velZ);
+}
+
+namespace {
+
+Vec3 SeparationPush(const SteeringParams& params, const SpatialGrid& grid, uint32_t self,
+                    Span<const float> posX, Span<const float> posY, Span<const float> posZ) {
+    constexpr size_t kLanes = (kMaxSeparationNeighbours + 3) / 4 * 4;
+    const float radius = params.separationRadius;
+    const float invRadius = 1.0f / radius;
+    const float x = posX[self];
+    const float z = posZ[self];
+    uint32_t ids[kLanes];
+    float nx[kLanes] = {}, nz[kLanes] = {};
+    const size_t count = grid.GatherInRadius(Vec3{ x, posY[self], z }, radius, self, kMaxSeparationNeighbours,
+                                             ids, nx, nz);
+
+    // Offsets, squared distances and weights (unit direction * (1 - d / R)
+    // per unit of offset) for all lanes at once; stacked lanes are fixed up
+    // below.
+    float dx[kLanes], dz[kLanes], d2[kLanes], w[kLanes];
+    size_t k = 0;
+#if GAME_SIMD_SSE2
+    const __m128 vx = _mm_set1_ps(x), vz = _mm_set1_ps(z);
+    const __m128 vRadius = _mm_set1_ps(radius), vInvRadius = _mm_set1_ps(invRadius);
+    const __m128 vEps = _mm_set1_ps(kEpsilon);
+    for (; k < count; k += 4) {
+        __m128 ox = _mm_sub_ps(vx, _mm_loadu_ps(nx + k));
+        __m128 oz = _mm_sub_ps(vz, _mm_loadu_ps(nz + k));
+        __m128 dd = _mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oz, oz));
+        __m128 d = _mm_sqrt_ps(_mm_max_ps(dd, vEps));
+        _mm_storeu_ps(dx + k, ox);
+        _mm_storeu_ps(dz + k, oz);
+        _mm_storeu_ps(d2 + k, dd);
+        _mm_storeu_ps(w + k, _mm_div_ps(_mm_mul_ps(_mm_sub_ps(vRadius, d), vInvRadius), d));
+    }
+#endif
+    for (; k < count; ++k) {
+        dx[k] = x - nx[k];
+        dz[k] = z - nz[k];
+        d2[k] = dx[k] * dx[k] + dz[k] * dz[k];
+        const float d = std::sqrt(std::max(d2[k], kEpsilon));
+        w[k] = (radius - d) * invRadius / d;
+    }
+
+    // Summed in neighbour order, so the result does not depend on the lane
+    // width.
+    float fx = 0.0f, fz = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        if (d2[i] > kEpsilon) {
+            fx += dx[i] * w[i];
+            fz += dz[i] * w[i];
+        } else {
+            // Stacked exactly (e.g. same spawn point): split by index.
+            fx += self < ids[i] ? 1.0f : -1.0f;
+        }
+    }
+    return Vec3{ fx, 0.0f, fz };
+}
+
+} // namespace
+
+void ComputeSeparation(const SteeringParams& params, const SpatialGrid& grid,
+                       Span<const float> posX, Span<const float> posY, Span<const float> posZ,
+                       Span<float> outX, Span<float> outZ) {
+    // Walk agents in grid order so consecutive queries touch the same cells.
+    for (uint32_t self : grid.SortedIds()) {
+        Vec3 f = SeparationPush(params, grid, self, posX, posY, posZ);
+        outX[self] = f.x;
+        outZ[self] = f.z;
+    }
+}
+
+void ComputeSeparation(const SteeringParams& params, const SpatialGrid& grid, Span<const uint32_t> agents,
+                       Span<const float> posX, Span<const float> posY, Span<const float> posZ,
+                       Span<float> outX, Span<float> outZ) {
+    for (size_t k = 0; k < agents.size(); ++k) {
+        Vec3 f = SeparationPush(params, grid, agents[k], posX, posY, posZ);
+        outX[k] = f.x;
+        outZ[k] = f.z;
+    }
+}
+
+void ApplyForce(float scale, Span<const float> forceX, Span<const float> forceZ,
+                Span<const float> maxSpeed, Span<float> velX, Span<float> velZ) {
+    const size_t n = velX.size();
+    size_t i = 0;
+#if GAME_SIMD_SSE2
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vEps = _mm_set1_ps(kEpsilon);
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(velX.data() + i), _mm_mul_ps(_mm_loadu_ps(forceX.data() + i), vScale));
+        __m128 vz = _mm_add_ps(_mm_loadu_ps(velZ.data() + i), _mm_mul_ps(_mm_loadu_ps(forceZ.data() + i), vScale));
+        __m128 len = _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vz, vz)), vEps));
+        __m128 clamp = _mm_min_ps(vOne, _mm_div_ps(_mm_loadu_ps(maxSpeed.data() + i), len));
+        _mm_storeu_ps(velX.data() + i, _mm_mul_ps(vx, clamp));
+        _mm_storeu_ps(velZ.data() + i, _mm_mul_ps(vz, clamp));
+    }
+#endif
+    for (; i < n; ++i) {
+        float vx = velX[i] + forceX[i] * scale;
+        float vz = velZ[i] + forceZ[i] * scale;
+        float len = std::sqrt(std::max(vx * vx + vz * vz, kEpsilon));
+        float clamp = std::min(1.0f, maxSpeed[i] / len);
+        velX[i] = vx * clamp;
+        velZ[i] = vz * clamp;
+    }
+}
+
+void Integrate(float dt, Span<const float> velX, Span<const float> velZ, Span<float> posX, Span<float> posZ) {
+    const size_t n = posX.size();
+    size_t i = 0;
+#if GAME_SIMD_SSE2
+    const __m128 vDt = _mm_set1_ps(dt);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(posX.data() + i, _mm_add_ps(_mm_loadu_ps(posX.data() + i), _mm_mul_ps(_mm_loadu_ps(velX.data() + i), vDt)));
+        _mm_storeu_ps(posZ.data() + i, _mm_add_ps(_mm_loadu_ps(posZ.data() + i), _mm_mul_ps(_mm_loadu_ps(velZ.data() + i), vDt)));
+    }
+#endif
+    for (; i < n; ++i) {
+        posX[i] += velX[i] * dt;
+        posZ[i] += velZ[i] * dt;
+    }
+}
+
+} // namespace game
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "SpatialGrid.h"
+#include "Span.h"
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Batch steering kernels over SoA agent columns (replaces the per-object
+// seek/arrive in game-ai-steering.js for server-side zombies). Everything is
+// on the x/z plane; all spans in one call have the same length. Seek, arrive,
+// force and integration passes are SSE2 with a scalar tail; separation
+// gathers neighbours with SSE2 distance tests and weights them four at a time.
+// ---------------------------------------------------------------------------
+struct SteeringParams {
+    float maxAccel = 24.0f;          // velocity change per second
+    float slowRadius = 3.0f;         // arrive: start slowing inside this distance
+    float stopRadius = 1.0f;         // arrive: desired speed is zero inside this
+    float separationRadius = 1.0f;
+    float separationWeight = 12.0f;  // acceleration at zero distance
+};
+
+// Turns velocity toward dir * maxSpeed, limited to maxAccel * dt. dir is a
+// unit (or zero) direction per agent.
+void SteerSeek(const SteeringParams& params, float dt,
+               Span<const float> dirX, Span<const float> dirZ, Span<const float> maxSpeed,
+               Span<float> velX, Span<float> velZ);
+
+// As SteerSeek, with the desired speed ramping from maxSpeed at slowRadius
+// down to zero at stopRadius; dist is each agent's distance to its target.
+void SteerArrive(const SteeringParams& params, float dt,
+                 Span<const float> dirX, Span<const float> dirZ, Span<const float> dist,
+                 Span<const float> maxSpeed, Span<float> velX, Span<float> velZ);
+
+// Writes each agent's separation push into outX/outZ: the sum over up to
+// kMaxSeparationNeighbours neighbours within separationRadius of a unit
+// push falling off linearly to zero at the radius. grid must hold every agent
+// keyed by its index in the position spans; a cell size of twice the radius
+// keeps each query to at most 2x2 cells. Pushes are summed in neighbour
+// order, so results match the scalar build bit for bit.
+inline constexpr int kMaxSeparationNeighbours = 8;
+void ComputeSeparation(const SteeringParams& params, const SpatialGrid& grid,
+                       Span<const float> posX, Span<const float> posY, Span<const float> posZ,
+                       Span<float> outX, Span<float> outZ);
+// Same push for the listed agents only (against every agent in grid);
+// outX[k] / outZ[k] belong to agents[k].
+void ComputeSeparation(const SteeringParams& params, const SpatialGrid& grid, Span<const uint32_t> agents,
+                       Span<const float> posX, Span<const float> posY, Span<const float> posZ,
+                       Span<float> outX, Span<float> outZ);
+
+// vel += force * scale, then clamps speed to maxSpeed.
+void ApplyForce(float scale, Span<const float> forceX, Span<const float> forceZ,
+                Span<const float> maxSpeed, Span<float> velX, Span<float> velZ);
+
+// pos += vel * dt.
+void Integrate(float dt, Span<const float> velX, Span<const float> velZ, Span<float> posX, Span<float> posZ);
+
+} // namespace game
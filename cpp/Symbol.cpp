@@ -0,0 +1,29 @@
+#include "Symbol.h"
+
+namespace game {
+
+SymbolTable& SymbolTable::Global() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::Intern(std::string_view text) {
+    const SymbolId id = SymbolHash(text);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = names_.try_emplace(id, text);
+    if (!inserted && it->second != text) return kNoSymbol;
+    return id;
+}
+
+std::string_view SymbolTable::Name(SymbolId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = names_.find(id);
+    return it != names_.end() ? std::string_view(it->second) : std::string_view();
+}
+
+size_t SymbolTable::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace game
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Interned tags (quest targets, mission targets, kill tags). A symbol's id is
+// the 32-bit FNV-1a hash of its text, so literals hash at compile time and
+// any string_view maps to its id without a table lookup; matching is then an
+// integer compare. The global table keeps the text of every registered
+// symbol for debugging and serialization and rejects hash collisions at
+// registration.
+// ---------------------------------------------------------------------------
+using SymbolId = uint32_t;
+inline constexpr SymbolId kNoSymbol = 0;
+
+constexpr SymbolId SymbolHash(std::string_view text) {
+    uint32_t h = 2166136261u;
+    for (char c : text) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h != kNoSymbol ? h : 1u;
+}
+
+// Tags the game code matches on.
+namespace sym {
+inline constexpr SymbolId kEnemy = SymbolHash("enemy");
+inline constexpr SymbolId kZombie = SymbolHash("zombie");
+inline constexpr SymbolId kFlagCapture = SymbolHash("flag_capture");
+inline constexpr SymbolId kControlPoint = SymbolHash("control_point");
+} // namespace sym
+
+class SymbolTable {
+public:
+    static SymbolTable& Global();
+
+    // Registers text and returns its id, or kNoSymbol if a different text
+    // already holds the same hash. Thread-safe; meant for registration time.
+    SymbolId Intern(std::string_view text);
+    // Text of a registered symbol (empty view if unknown). The view stays
+    // valid for the table's lifetime.
+    std::string_view Name(SymbolId id) const;
+    size_t Size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<SymbolId, std::string> names_;
+};
+
+inline SymbolId InternSymbol(std::string_view text) { return SymbolTable::Global().Intern(text); }
+inline std::string_view SymbolName(SymbolId id) { return SymbolTable::Global().Name(id); }
+
+} // namespace game
@@ -0,0 +1,167 @@
+#include "TeamBalance.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace game {
+
+namespace {
+
+int LowestSetBit(uint64_t v) {
+    int bit = 0;
+    while (!(v & 1u)) {
+        v >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+bool Better(int sizeDiff, int64_t ratingDiff, int bestSizeDiff, int64_t bestRatingDiff) {
+    return sizeDiff != bestSizeDiff ? sizeDiff < bestSizeDiff : ratingDiff < bestRatingDiff;
+}
+
+} // namespace
+
+void TeamBalancer::BuildUnits(Span<const BalanceMember> members) {
+    order_.resize(members.size());
+    for (size_t i = 0; i < members.size(); ++i)
+        order_[i] = static_cast<uint32_t>(i);
+    std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+        return members[a].partyId < members[b].partyId;
+    });
+
+    units_.clear();
+    memberUnit_.assign(members.size(), -1);
+    uint32_t lastParty = 0;
+    for (uint32_t idx : order_) {
+        const BalanceMember& m = members[idx];
+        if (m.partyId == 0 || units_.empty() || m.partyId != lastParty)
+            units_.push_back(Unit{});
+        lastParty = m.partyId;
+        units_.back().rating += m.rating;
+        units_.back().size++;
+        memberUnit_[idx] = static_cast<int32_t>(units_.size() - 1);
+    }
+}
+
+uint64_t TeamBalancer::SolveExact(int64_t total, int32_t count) {
+    // Unit 0 is pinned to Alpha (the mirror split scores the same); bit i of
+    // the mask puts unit i+1 on Alpha. Gray code changes one unit per step.
+    const size_t free = units_.size() - 1;
+    int64_t sumA = units_[0].rating;
+    int32_t cntA = units_[0].size;
+    uint64_t mask = 0;
+    uint64_t bestMask = 0;
+    int bestSize = std::abs(2 * cntA - count);
+    int64_t bestDiff = std::llabs(2 * sumA - total);
+
+    const uint64_t steps = 1ull << free;
+    for (uint64_t k = 1; k < steps; ++k) {
+        int bit = LowestSetBit(k);
+        const Unit& u = units_[static_cast<size_t>(bit) + 1];
+        mask ^= 1ull << bit;
+        if (mask & (1ull << bit)) {
+            sumA += u.rating;
+            cntA += u.size;
+        } else {
+            sumA -= u.rating;
+            cntA -= u.size;
+        }
+        int sizeDiff = std::abs(2 * cntA - count);
+        int64_t ratingDiff = std::llabs(2 * sumA - total);
+        if (Better(sizeDiff, ratingDiff, bestSize, bestDiff)) {
+            bestSize = sizeDiff;
+            bestDiff = ratingDiff;
+            bestMask = mask;
+        }
+    }
+    return bestMask;
+}
+
+void TeamBalancer::SolveHeuristic(int32_t count) {
+    // Greedy: biggest parties first, each to the weaker team that still has room.
+    order_.resize(units_.size());
+    for (size_t i = 0; i < units_.size(); ++i)
+        order_[i] = static_cast<uint32_t>(i);
+    std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+        if (units_[a].size != units_[b].size) return units_[a].size > units_[b].size;
+        return units_[a].rating > units_[b].rating;
+    });
+
+    const int32_t cap = (count + 1) / 2;
+    int64_t sumA = 0, sumB = 0;
+    int32_t cntA = 0, cntB = 0;
+    for (uint32_t u : order_) {
+        const Unit& unit = units_[u];
+        bool fitsA = cntA + unit.size <= cap;
+        bool fitsB = cntB + unit.size <= cap;
+        bool toA = (fitsA && fitsB) ? sumA <= sumB : (fitsA || (!fitsB && cntA <= cntB));
+        unitOnAlpha_[u] = toA ? 1 : 0;
+        if (toA) { sumA += unit.rating; cntA += unit.size; }
+        else     { sumB += unit.rating; cntB += unit.size; }
+    }
+
+    // Refine: best same-size swap per pass while it narrows the gap.
+    for (int pass = 0; pass < 16; ++pass) {
+        int64_t diff = sumA - sumB;
+        int64_t bestDiff = std::llabs(diff);
+        size_t bestI = 0, bestJ = 0;
+        bool found = false;
+        for (size_t i = 0; i < units_.size(); ++i) {
+            if (!unitOnAlpha_[i]) continue;
+            for (size_t j = 0; j < units_.size(); ++j) {
+                if (unitOnAlpha_[j] || units_[i].size != units_[j].size) continue;
+                int64_t d = std::llabs(diff - 2 * (units_[i].rating - units_[j].rating));
+                if (d < bestDiff) {
+                    bestDiff = d;
+                    bestI = i;
+                    bestJ = j;
+                    found = true;
+                }
+            }
+        }
+        if (!found) break;
+        unitOnAlpha_[bestI] = 0;
+        unitOnAlpha_[bestJ] = 1;
+        sumA += units_[bestJ].rating - units_[bestI].rating;
+        sumB += units_[bestI].rating - units_[bestJ].rating;
+    }
+}
+
+void TeamBalancer::Solve(Span<const BalanceMember> members, TeamSplit& out) {
+    out.teams.assign(members.size(), Team::Alpha);
+    out.ratingDiff = 0;
+    out.sizeDiff = static_cast<int>(members.size());
+    out.exact = true;
+    if (members.empty()) return;
+
+    BuildUnits(members);
+    int64_t total = 0;
+    for (const auto& u : units_) total += u.rating;
+    int32_t count = static_cast<int32_t>(members.size());
+
+    unitOnAlpha_.assign(units_.size(), 0);
+    if (units_.size() <= static_cast<size_t>(kExactMaxUnits)) {
+        uint64_t mask = SolveExact(total, count);
+        unitOnAlpha_[0] = 1;
+        for (size_t u = 1; u < units_.size(); ++u)
+            unitOnAlpha_[u] = (mask >> (u - 1)) & 1u;
+    } else {
+        out.exact = false;
+        SolveHeuristic(count);
+    }
+
+    int64_t sumA = 0;
+    int32_t cntA = 0;
+    for (size_t i = 0; i < members.size(); ++i) {
+        bool alpha = unitOnAlpha_[static_cast<size_t>(memberUnit_[i])] != 0;
+        out.teams[i] = alpha ? Team::Alpha : Team::Bravo;
+        if (alpha) {
+            sumA += members[i].rating;
+            cntA++;
+        }
+    }
+    out.ratingDiff = std::llabs(2 * sumA - total);
+    out.sizeDiff = std::abs(2 * cntA - count);
+}
+
+} // namespace game
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "Span.h"
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Skill-balanced Alpha/Bravo assignment for a lobby. Party members always
+// land on the same team. Team sizes are kept as even as the parties allow,
+// then the rating-sum difference is minimised: exactly (Gray-code walk over
+// every split) up to kExactMaxUnits parties/solos, by greedy placement plus
+// pairwise swap refinement above that.
+// ---------------------------------------------------------------------------
+inline constexpr int kExactMaxUnits = 16;
+
+struct BalanceMember {
+    PlayerId playerId = 0;
+    int32_t rating = 0;
+    uint32_t partyId = 0;  // 0 = solo
+};
+
+struct TeamSplit {
+    std::vector<Team> teams;  // parallel to the input members
+    int64_t ratingDiff = 0;   // |sum(Alpha) - sum(Bravo)|
+    int sizeDiff = 0;         // |count(Alpha) - count(Bravo)|
+    bool exact = false;
+};
+
+class TeamBalancer {
+public:
+    void Solve(Span<const BalanceMember> members, TeamSplit& out);
+
+private:
+    struct Unit {
+        int64_t rating = 0;
+        int32_t size = 0;
+    };
+
+    void BuildUnits(Span<const BalanceMember> members);
+    uint64_t SolveExact(int64_t total, int32_t count);
+    void SolveHeuristic(int32_t count);
+
+    std::vector<Unit> units_;
+    std::vector<int32_t> memberUnit_;  // member index -> unit index
+    std::vector<uint32_t> order_;
+    std::vector<uint8_t> unitOnAlpha_;
+};
+
+} // namespace game
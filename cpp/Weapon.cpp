@@ -1,4 +1,5 @@
 #include "Weapon.h"
+#include "Analytics.h"
 #include <algorithm>
 #include <cmath>
 
@@ -201,6 +202,8 @@ bool WeaponProgression::PrestigeWeapon(WeaponId weaponId, PlayerId playerId) {
     state->prestige++;
     state->currentXp = 0;
     RecalcXpToNext(*state);
+    if (analytics_)
+        analytics_->Record(analyticsProducer_, ProgressionKind::WeaponPrestige, playerId, weaponId, 0, state->prestige);
     return true;
 }
 
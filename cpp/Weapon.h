@@ -7,6 +7,8 @@
 
 namespace game {
 
+class ProgressionAnalytics;
+
 class WeaponRegistry {
 public:
     WeaponRegistry() { Init(); }
@@ -52,10 +54,19 @@ public:
     const WeaponProgressionState* GetState(PlayerId playerId, WeaponId weaponId) const;
     WeaponProgressionState* GetOrCreateState(PlayerId playerId, WeaponId weaponId);
 
+    // Successful prestiges also go to analytics as `producer`, with the new
+    // prestige level; nullptr detaches.
+    void SetAnalytics(ProgressionAnalytics* analytics, size_t producer) {
+        analytics_ = analytics;
+        analyticsProducer_ = producer;
+    }
+
 private:
     void RecalcXpToNext(WeaponProgressionState& state) const;
 
     std::unordered_map<PlayerId, std::unordered_map<WeaponId, WeaponProgressionState>> playerWeapons_;
+    ProgressionAnalytics* analytics_ = nullptr;
+    size_t analyticsProducer_ = 0;
 };
 
 } // namespace game
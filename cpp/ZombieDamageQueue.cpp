@@ -0,0 +1,47 @@
+#include "ZombieDamageQueue.h"
+#include <algorithm>
+
+namespace game {
+
+void ZombieDamageQueue::Init(size_t producers, size_t capacityPerProducer) {
+    rings_.clear();
+    rings_.reserve(producers);
+    for (size_t i = 0; i < producers; ++i)
+        rings_.push_back(std::make_unique<SpscRing<ZombieHit>>(capacityPerProducer));
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+bool ZombieDamageQueue::Push(size_t producer, const ZombieHit& hit) {
+    if (producer < rings_.size() && rings_[producer]->TryPush(hit)) return true;
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t ZombieDamageQueue::Drain(std::vector<ZombieHit>& out) {
+    size_t drained = 0;
+    for (auto& ring : rings_)
+        drained += ring->PopAll([&](const ZombieHit& hit) { out.push_back(hit); });
+    return drained;
+}
+
+size_t CoalesceZombieHits(Span<const ZombieHit> hits, std::vector<uint64_t>& keys, std::vector<ZombieHit>& out) {
+    out.clear();
+    if (hits.empty()) return 0;
+
+    // Sort by (zombie, arrival index): groups each zombie's hits, in order.
+    keys.resize(hits.size());
+    for (size_t i = 0; i < hits.size(); ++i)
+        keys[i] = (static_cast<uint64_t>(hits[i].zombieId) << 32) | static_cast<uint32_t>(i);
+    std::sort(keys.begin(), keys.end());
+
+    for (uint64_t key : keys) {
+        const ZombieHit& hit = hits[static_cast<uint32_t>(key)];
+        if (!out.empty() && out.back().zombieId == hit.zombieId && out.back().attackerId == hit.attackerId)
+            out.back().damage += hit.damage;
+        else
+            out.push_back(hit);
+    }
+    return out.size();
+}
+
+} // namespace game
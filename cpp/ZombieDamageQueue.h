@@ -0,0 +1,49 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "Span.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace game {
+
+// ---------------------------------------------------------------------------
+// Hand-off of zombie hits from network threads to the sim thread. Each
+// producer thread owns one SPSC ring (by index), so Push never locks or
+// allocates; the sim thread drains every ring at the start of a tick. Hits
+// from one producer stay in order; hits from different producers are
+// concurrent anyway, so no order is kept between rings.
+// ---------------------------------------------------------------------------
+class ZombieDamageQueue {
+public:
+    // Not thread-safe: size the rings before any producer starts. Until then
+    // the queue has no producers and Push always fails.
+    void Init(size_t producers, size_t capacityPerProducer);
+    size_t ProducerCount() const { return rings_.size(); }
+
+    // Producer thread `producer` only. Returns false (and counts the hit as
+    // dropped) when that producer's ring is full or the index is invalid.
+    bool Push(size_t producer, const ZombieHit& hit);
+
+    // Sim thread only. Appends every queued hit to out; returns how many.
+    size_t Drain(std::vector<ZombieHit>& out);
+
+    uint64_t DroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<std::unique_ptr<SpscRing<ZombieHit>>> rings_;
+    std::atomic<uint64_t> dropped_{ 0 };
+};
+
+// Merges hits without changing who gets credited for a kill: hits are
+// grouped by zombie (keeping their order within a zombie) and each run of
+// consecutive hits from the same attacker becomes one hit. ZombieStore
+// credits the hit that takes health to zero, and within a merged run that
+// is the same attacker. Writes the merged hits to out (keys is scratch);
+// returns out.size().
+size_t CoalesceZombieHits(Span<const ZombieHit> hits, std::vector<uint64_t>& keys, std::vector<ZombieHit>& out);
+
+} // namespace game
@@ -0,0 +1,152 @@
+#include "ZombieStore.h"
+#include "Simd.h"
+
+namespace game {
+
+namespace {
+
+template <typename T>
+void SwapRemove(std::vector<T>& column, size_t i) {
+    if (i != column.size() - 1)
+        column[i] = column.back();
+    column.pop_back();
+}
+
+// health[i] -= pending[i]; pending[i] = 0; appends i to dying when the
+// result is <= 0. Every stored zombie is alive, so no flag test is needed.
+void SubtractPendingDamage(float* health, float* pending, size_t n, std::vector<uint32_t>& dying) {
+    size_t i = 0;
+#if GAME_SIMD_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 h = _mm_sub_ps(_mm_loadu_ps(health + i), _mm_loadu_ps(pending + i));
+        _mm_storeu_ps(health + i, h);
+        _mm_storeu_ps(pending + i, zero);
+        int dead = _mm_movemask_ps(_mm_cmple_ps(h, zero));
+        if (dead == 0) continue;
+        for (uint32_t lane = 0; lane < 4; ++lane)
+            if (dead & (1 << lane))
+                dying.push_back(static_cast<uint32_t>(i) + lane);
+    }
+#endif
+    for (; i < n; ++i) {
+        health[i] -= pending[i];
+        pending[i] = 0.0f;
+        if (health[i] <= 0.0f)
+            dying.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+} // namespace
+
+void ZombieStore::Reserve(size_t capacity) {
+    index_.Reserve(capacity);
+    health_.reserve(capacity);
+    maxHealth_.reserve(capacity);
+    type_.reserve(capacity);
+    posX_.reserve(capacity);
+    posY_.reserve(capacity);
+    posZ_.reserve(capacity);
+    velX_.reserve(capacity);
+    velZ_.reserve(capacity);
+    maxSpeed_.reserve(capacity);
+    flags_.reserve(capacity);
+    pending_.reserve(capacity);
+    killer_.reserve(capacity);
+    dying_.reserve(capacity);
+}
+
+uint32_t ZombieStore::Insert(ZombieType type, float maxHealth, float maxSpeed, const Vec3& position) {
+    uint32_t id = index_.Insert();
+    if (id == 0) return 0;
+    health_.push_back(maxHealth);
+    maxHealth_.push_back(maxHealth);
+    type_.push_back(type);
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    posZ_.push_back(position.z);
+    velX_.push_back(0.0f);
+    velZ_.push_back(0.0f);
+    maxSpeed_.push_back(maxSpeed);
+    flags_.push_back(kZombieAlive);
+    pending_.push_back(0.0f);
+    killer_.push_back(0);
+    return id;
+}
+
+bool ZombieStore::Erase(uint32_t zombieId) {
+    int64_t dense = index_.Erase(zombieId);
+    if (dense < 0) return false;
+    size_t i = static_cast<size_t>(dense);
+    SwapRemove(health_, i);
+    SwapRemove(maxHealth_, i);
+    SwapRemove(type_, i);
+    SwapRemove(posX_, i);
+    SwapRemove(posY_, i);
+    SwapRemove(posZ_, i);
+    SwapRemove(velX_, i);
+    SwapRemove(velZ_, i);
+    SwapRemove(maxSpeed_, i);
+    SwapRemove(flags_, i);
+    SwapRemove(pending_, i);
+    SwapRemove(killer_, i);
+    return true;
+}
+
+void ZombieStore::Clear() {
+    index_.Clear();
+    health_.clear();
+    maxHealth_.clear();
+    type_.clear();
+    posX_.clear();
+    posY_.clear();
+    posZ_.clear();
+    velX_.clear();
+    velZ_.clear();
+    maxSpeed_.clear();
+    flags_.clear();
+    pending_.clear();
+    killer_.clear();
+}
+
+bool ZombieStore::SetPosition(uint32_t zombieId, const Vec3& position) {
+    int64_t dense = index_.IndexOf(zombieId);
+    if (dense < 0) return false;
+    size_t i = static_cast<size_t>(dense);
+    posX_[i] = position.x;
+    posY_[i] = position.y;
+    posZ_[i] = position.z;
+    return true;
+}
+
+void ZombieStore::ApplyDamage(Span<const ZombieHit> hits, std::vector<ZombieDeath>& deaths) {
+    // Scatter: accumulate each zombie's damage in hit order. Damage only
+    // grows, so the first hit whose running total reaches the zombie's health
+    // is the one that kills it.
+    bool any = false;
+    for (const ZombieHit& hit : hits) {
+        int64_t d = index_.IndexOf(hit.zombieId);
+        if (d < 0 || !(hit.damage > 0.0f)) continue;
+        size_t i = static_cast<size_t>(d);
+        pending_[i] += hit.damage;
+        any = true;
+        if (!(flags_[i] & kZombieKillCredited) && pending_[i] >= health_[i]) {
+            flags_[i] |= kZombieKillCredited;
+            killer_[i] = hit.attackerId;
+        }
+    }
+    if (!any) return;
+
+    // Vector pass: apply and clear the accumulated damage, collect the dead.
+    // health - pending <= 0 exactly when pending >= health, so the dead set
+    // matches the credited set.
+    dying_.clear();
+    SubtractPendingDamage(health_.data(), pending_.data(), health_.size(), dying_);
+
+    for (uint32_t i : dying_) {
+        flags_[i] &= static_cast<uint8_t>(~(kZombieAlive | kZombieKillCredited));
+        deaths.push_back(ZombieDeath{ index_.HandleAt(i), killer_[i], type_[i] });
+    }
+}
+
+} // namespace game
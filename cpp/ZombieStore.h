@@ -0,0 +1,119 @@
+#pragma once
+
+#include "GameTypes.h"
+#include "SlotMap.h"
+#include "Span.h"
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+// Zombie flag bits (ZombieStore::Flags column).
+inline constexpr uint8_t kZombieAlive = 1u << 0;
+inline constexpr uint8_t kZombieKillCredited = 1u << 1;  // set during ApplyDamage only
+
+// Writable movement columns for the steering kernels (all length Size()).
+struct ZombieKinematics {
+    Span<float> posX;
+    Span<float> posY;
+    Span<float> posZ;
+    Span<float> velX;
+    Span<float> velZ;
+    Span<const float> maxSpeed;
+};
+
+struct ZombieDeath {
+    uint32_t zombieId = 0;
+    PlayerId killerId = 0;  // attacker whose hit took health to zero
+    ZombieType type = ZombieType::Walker;
+};
+
+class ZombieStore;
+
+// Read-only handle on one stored zombie: reads straight from the columns, so
+// it is only valid until the store is next modified.
+class ZombieRef {
+public:
+    ZombieRef(const ZombieStore& store, size_t index) : store_(&store), index_(index) {}
+
+    size_t Index() const { return index_; }
+    uint32_t Id() const;
+    ZombieType Type() const;
+    float Health() const;
+    float MaxHealth() const;
+    Vec3 Position() const;
+    Vec3 Velocity() const;  // y is always 0
+    bool Alive() const;
+
+private:
+    const ZombieStore* store_;
+    size_t index_;
+};
+
+// ---------------------------------------------------------------------------
+// Structure-of-arrays zombie storage: one dense column per component, all
+// indexed by the SlotIndex dense index and swap-removed together. Zombie ids
+// are the SlotIndex handles.
+// ---------------------------------------------------------------------------
+class ZombieStore {
+public:
+    void Reserve(size_t capacity);
+    uint32_t Insert(ZombieType type, float maxHealth, float maxSpeed, const Vec3& position);
+    bool Erase(uint32_t zombieId);
+    void Clear();
+    bool SetPosition(uint32_t zombieId, const Vec3& position);
+
+    bool Contains(uint32_t zombieId) const { return index_.Contains(zombieId); }
+    int64_t IndexOf(uint32_t zombieId) const { return index_.IndexOf(zombieId); }
+    uint32_t IdAt(size_t i) const { return index_.HandleAt(i); }
+    size_t Size() const { return index_.Size(); }
+    size_t Capacity() const { return index_.Capacity(); }
+
+    Span<const float> Health() const { return health_; }
+    Span<const float> MaxHealth() const { return maxHealth_; }
+    Span<const ZombieType> Types() const { return type_; }
+    Span<const float> PosX() const { return posX_; }
+    Span<const float> PosY() const { return posY_; }
+    Span<const float> PosZ() const { return posZ_; }
+    Span<const float> VelX() const { return velX_; }
+    Span<const float> VelZ() const { return velZ_; }
+    Span<const float> MaxSpeed() const { return maxSpeed_; }
+    Span<const uint8_t> Flags() const { return flags_; }
+    ZombieKinematics Kinematics() { return { posX_, posY_, posZ_, velX_, velZ_, maxSpeed_ }; }
+    ZombieRef At(size_t i) const { return ZombieRef(*this, i); }
+
+    // Applies every hit (stale ids are skipped) and appends one ZombieDeath
+    // per zombie whose health reached zero, credited to the hit that crossed
+    // it. Dead zombies stay stored (health <= 0) until the caller erases them.
+    void ApplyDamage(Span<const ZombieHit> hits, std::vector<ZombieDeath>& deaths);
+
+private:
+    SlotIndex index_;
+    std::vector<float> health_;
+    std::vector<float> maxHealth_;
+    std::vector<ZombieType> type_;
+    std::vector<float> posX_;
+    std::vector<float> posY_;
+    std::vector<float> posZ_;
+    std::vector<float> velX_;  // horizontal velocity (x/z plane)
+    std::vector<float> velZ_;
+    std::vector<float> maxSpeed_;
+    std::vector<uint8_t> flags_;
+
+    // ApplyDamage scratch, kept sized with the columns (zero between calls).
+    std::vector<float> pending_;
+    std::vector<PlayerId> killer_;
+    std::vector<uint32_t> dying_;
+};
+
+inline uint32_t ZombieRef::Id() const { return store_->IdAt(index_); }
+inline ZombieType ZombieRef::Type() const { return store_->Types()[index_]; }
+inline float ZombieRef::Health() const { return store_->Health()[index_]; }
+inline float ZombieRef::MaxHealth() const { return store_->MaxHealth()[index_]; }
+inline Vec3 ZombieRef::Position() const {
+    return Vec3{ store_->PosX()[index_], store_->PosY()[index_], store_->PosZ()[index_] };
+}
+inline Vec3 ZombieRef::Velocity() const { return Vec3{ store_->VelX()[index_], 0.0f, store_->VelZ()[index_] }; }
+inline bool ZombieRef::Alive() const { return (store_->Flags()[index_] & kZombieAlive) != 0; }
+
+} // namespace game
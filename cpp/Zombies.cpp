@@ -1,6 +1,7 @@
 #include "Zombies.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace game {
 
@@ -15,13 +16,34 @@ constexpr int kRunnerPoints = 90;
 constexpr int kBrutePoints = 250;
 constexpr int kBossPoints = 1500;
 constexpr float kHealthPerRound = 1.1f;
+constexpr float kWalkerSpeed = 2.5f;   // m/s
+constexpr float kRunnerSpeed = 5.0f;
+constexpr float kBruteSpeed = 2.0f;
+constexpr float kBossSpeed = 3.0f;
+constexpr float kTwoPi = 6.28318531f;
 
 } // namespace
 
+ZombiesMode::ZombiesMode() : separationGrid_(2.0f * SteeringParams{}.separationRadius) {
+    zombies_.Reserve(static_cast<size_t>(spawnConfig_.maxAlive));
+}
+
+void ZombiesMode::SetSpawnConfig(const ZombieSpawnConfig& config) {
+    spawnConfig_ = config;
+    // The alive cap bounds storage: reserve it once so spawns never allocate.
+    if (static_cast<size_t>(config.maxAlive) > zombies_.Capacity())
+        zombies_.Reserve(static_cast<size_t>(config.maxAlive));
+}
+
 void ZombiesMode::Reset() {
-    nextZombieId_ = 1;
     roundState_ = ZombiesRoundState{};
-    zombies_.clear();
+    zombies_.Clear();
+    std::fill(std::begin(queued_), std::end(queued_), 0);
+    queuedHealthMultiplier_ = 1.0f;
+    nextSpawnType_ = 0;
+    spawnRng_.seed(kSpawnSeed);
+    lodTick_ = 0;
+    lodStats_ = AiLodStats{};
     for (auto& [p, ps] : players_) {
         ps.points = 0;
         ps.lives = 3;
@@ -42,6 +64,7 @@ void ZombiesMode::AddPlayer(PlayerId playerId) {
 
 void ZombiesMode::RemovePlayer(PlayerId playerId) {
     players_.erase(playerId);
+    navigation_.RemoveTarget(playerId);
 }
 
 ZombieWaveConfig ZombiesMode::GetWaveConfig(int round) const {
@@ -61,43 +84,110 @@ ZombieWaveConfig ZombiesMode::GetWaveConfig(int round) const {
     return cfg;
 }
 
-void ZombiesMode::SpawnZombie(ZombieType type, float healthMultiplier) {
-    ZombieInstance z;
-    z.id = nextZombieId_++;
-    z.type = type;
-    z.alive = true;
-
+bool ZombiesMode::SpawnZombie(ZombieType type, float healthMultiplier, const Vec3& position) {
+    float maxHealth = 0.0f;
+    float speed = 0.0f;
     switch (type) {
     case ZombieType::Walker:
-        z.maxHealth = kWalkerBaseHealth * healthMultiplier;
+        maxHealth = kWalkerBaseHealth * healthMultiplier;
+        speed = kWalkerSpeed;
         break;
     case ZombieType::Runner:
-        z.maxHealth = kRunnerBaseHealth * healthMultiplier;
+        maxHealth = kRunnerBaseHealth * healthMultiplier;
+        speed = kRunnerSpeed;
         break;
     case ZombieType::Brute:
-        z.maxHealth = kBruteBaseHealth * healthMultiplier;
+        maxHealth = kBruteBaseHealth * healthMultiplier;
+        speed = kBruteSpeed;
         break;
     case ZombieType::Boss:
-        z.maxHealth = kBossBaseHealth * healthMultiplier;
+        maxHealth = kBossBaseHealth * healthMultiplier;
+        speed = kBossSpeed;
         break;
     }
-    z.health = z.maxHealth;
-    zombies_[z.id] = std::move(z);
+    if (zombies_.Insert(type, maxHealth, speed, position) == 0) return false;  // slot space exhausted
     roundState_.zombiesSpawnedThisRound++;
-    roundState_.zombiesRemaining++;
+    return true;
 }
 
-void ZombiesMode::SpawnWave() {
-    ZombieWaveConfig cfg = GetWaveConfig(roundState_.currentRound);
+void ZombiesMode::QueueWave(const ZombieWaveConfig& wave) {
+    queued_[static_cast<int>(ZombieType::Walker)] += wave.walkerCount;
+    queued_[static_cast<int>(ZombieType::Runner)] += wave.runnerCount;
+    queued_[static_cast<int>(ZombieType::Brute)] += wave.bruteCount;
+    queued_[static_cast<int>(ZombieType::Boss)] += wave.bossSpawn ? 1 : 0;
+    queuedHealthMultiplier_ = wave.healthMultiplier;
 
-    for (int i = 0; i < cfg.walkerCount; ++i)
-        SpawnZombie(ZombieType::Walker, cfg.healthMultiplier);
-    for (int i = 0; i < cfg.runnerCount; ++i)
-        SpawnZombie(ZombieType::Runner, cfg.healthMultiplier);
-    for (int i = 0; i < cfg.bruteCount; ++i)
-        SpawnZombie(ZombieType::Brute, cfg.healthMultiplier);
-    if (cfg.bossSpawn)
-        SpawnZombie(ZombieType::Boss, cfg.healthMultiplier);
+    int total = wave.walkerCount + wave.runnerCount + wave.bruteCount + (wave.bossSpawn ? 1 : 0);
+    roundState_.zombiesQueued += total;
+    roundState_.zombiesRemaining += total;
+}
+
+void ZombiesMode::ReleaseSpawns() {
+    int budget = std::min(spawnConfig_.maxSpawnsPerTick,
+                          spawnConfig_.maxAlive - static_cast<int>(zombies_.Size()));
+    while (budget > 0 && roundState_.zombiesQueued > 0) {
+        // Rotate through the types still queued so a wave arrives mixed.
+        int type = nextSpawnType_;
+        for (int step = 1; step < kZombieTypeCount && queued_[type] == 0; ++step) type = (type + 1) % kZombieTypeCount;
+        if (queued_[type] == 0) {  // per-type counts exhausted; nothing left to release
+            roundState_.zombiesQueued = 0;
+            return;
+        }
+        nextSpawnType_ = static_cast<uint8_t>((type + 1) % kZombieTypeCount);
+
+        if (!SpawnZombie(static_cast<ZombieType>(type), queuedHealthMultiplier_, PickSpawnPosition()))
+            return;
+        queued_[type]--;
+        roundState_.zombiesQueued--;
+        budget--;
+    }
+}
+
+Vec3 ZombiesMode::PickSpawnPosition() {
+    // Anchor on a random standing player.
+    const ZombiesPlayerState* anchor = nullptr;
+    uint32_t seen = 0;
+    for (const auto& [id, ps] : players_) {
+        if (!ps.alive || ps.downed) continue;
+        if (std::uniform_int_distribution<uint32_t>(0, seen++)(spawnRng_) == 0)
+            anchor = &ps;
+    }
+    if (!anchor) return Vec3{};
+    const Vec3& p = anchor->position;
+
+    const float min2 = spawnConfig_.minSpawnDistance * spawnConfig_.minSpawnDistance;
+    const float max2 = spawnConfig_.maxSpawnDistance * spawnConfig_.maxSpawnDistance;
+    const Vec3* pick = nullptr;
+    const Vec3* nearestOutside = nullptr;
+    float nearestD2 = 0.0f;
+    seen = 0;
+    for (const Vec3& sp : spawnPoints_) {
+        float dx = sp.x - p.x, dy = sp.y - p.y, dz = sp.z - p.z;
+        float d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 >= min2 && d2 <= max2) {
+            if (std::uniform_int_distribution<uint32_t>(0, seen++)(spawnRng_) == 0)
+                pick = &sp;
+        } else if (d2 >= min2 && (!nearestOutside || d2 < nearestD2)) {
+            nearestOutside = &sp;
+            nearestD2 = d2;
+        }
+    }
+    if (pick) return *pick;
+    if (nearestOutside) return *nearestOutside;
+
+    // No usable spawn point: a ring at the near edge of the band, retrying a
+    // few angles to land on a walkable cell when a nav grid is set.
+    const NavGrid& grid = navigation_.Grid();
+    const float r = spawnConfig_.minSpawnDistance;
+    Vec3 pos = p;
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        float angle = std::uniform_real_distribution<float>(0.0f, kTwoPi)(spawnRng_);
+        pos = Vec3{ p.x + r * std::cos(angle), p.y, p.z + r * std::sin(angle) };
+        int32_t cell = grid.CellAt(pos.x, pos.z);
+        if (grid.CellCount() == 0 || (cell >= 0 && grid.Walkable(cell)))
+            break;
+    }
+    return pos;
 }
 
 void ZombiesMode::StartRound() {
@@ -105,20 +195,223 @@ void ZombiesMode::StartRound() {
     roundState_.zombiesSpawnedThisRound = 0;
     roundState_.zombiesKilledThisRound = 0;
     roundState_.zombiesRemaining = 0;
+    roundState_.zombiesQueued = 0;
+    std::fill(std::begin(queued_), std::end(queued_), 0);
     roundState_.roundActive = true;
     roundState_.roundComplete = false;
 
-    SpawnWave();
+    QueueWave(GetWaveConfig(roundState_.currentRound));
 
     if (onRoundEvent_)
         onRoundEvent_(roundState_.currentRound, true);
 }
 
 void ZombiesMode::Tick(float deltaSec) {
-    (void)deltaSec;
+    ReleaseSpawns();
+    UpdateNavigationTargets();
+    MoveZombies(deltaSec);
+    RebuildSpatialIndex();
     CheckRoundComplete();
 }
 
+void ZombiesMode::ScheduleAiLod(size_t tierEnd[3]) {
+    const size_t n = zombies_.Size();
+    const uint32_t tick = lodTick_++;
+    lodStats_ = AiLodStats{};
+
+    lodPlayerX_.clear();
+    lodPlayerZ_.clear();
+    for (const auto& [id, ps] : players_) {
+        if (!ps.alive || ps.downed) continue;
+        lodPlayerX_.push_back(ps.position.x);
+        lodPlayerZ_.push_back(ps.position.z);
+    }
+    const float near2 = lodConfig_.nearDistance * lodConfig_.nearDistance;
+    const float mid2 = lodConfig_.midDistance * lodConfig_.midDistance;
+    const uint32_t interval[3] = { 1u, static_cast<uint32_t>(std::max(lodConfig_.midInterval, 1)),
+                                   static_cast<uint32_t>(std::max(lodConfig_.farInterval, 1)) };
+    Span<const float> xs = zombies_.PosX();
+    Span<const float> zs = zombies_.PosZ();
+
+    // Tier each zombie (0xFF = coasting this tick), then counting-sort the
+    // ones due into moveActive_ so each tier is one contiguous range.
+    size_t count[3] = {};
+    moveTier_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t tier = 0;
+        if (lodConfig_.enabled) {
+            float best = std::numeric_limits<float>::max();
+            for (size_t p = 0; p < lodPlayerX_.size(); ++p) {
+                float dx = xs[i] - lodPlayerX_[p], dz = zs[i] - lodPlayerZ_[p];
+                best = std::min(best, dx * dx + dz * dz);
+            }
+            tier = best <= near2 ? 0 : best <= mid2 ? 1 : 2;
+        }
+        if (tier == 0) lodStats_.nearCount++;
+        else if (tier == 1) lodStats_.midCount++;
+        else lodStats_.farCount++;
+        // Ids are stable for a zombie's life, so its phase is too.
+        if ((tick + zombies_.IdAt(i)) % interval[tier] != 0) tier = 0xFF;
+        else count[tier]++;
+        moveTier_[i] = tier;
+    }
+    tierEnd[0] = count[0];
+    tierEnd[1] = tierEnd[0] + count[1];
+    tierEnd[2] = tierEnd[1] + count[2];
+    size_t next[3] = { 0, tierEnd[0], tierEnd[1] };
+    moveActive_.resize(tierEnd[2]);
+    for (size_t i = 0; i < n; ++i)
+        if (moveTier_[i] != 0xFF) moveActive_[next[moveTier_[i]]++] = static_cast<uint32_t>(i);
+
+    lodStats_.updated = tierEnd[2];
+    lodStats_.saved = n - tierEnd[2];
+}
+
+void ZombiesMode::MoveZombies(float deltaSec) {
+    const size_t n = zombies_.Size();
+    if (n == 0 || deltaSec <= 0.0f) return;
+    ZombieKinematics k = zombies_.Kinematics();
+
+    size_t tierEnd[3];
+    ScheduleAiLod(tierEnd);
+    const size_t m = tierEnd[2];
+
+    // Separation neighbours include coasting zombies, so the grid holds all.
+    moveIndex_.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        moveIndex_[i] = static_cast<uint32_t>(i);
+    separationGrid_.Build(moveIndex_, k.posX, k.posY, k.posZ);
+
+    if (m > 0) {
+        movePosX_.resize(m);
+        movePosZ_.resize(m);
+        moveVelX_.resize(m);
+        moveVelZ_.resize(m);
+        moveMaxSpeed_.resize(m);
+        for (size_t j = 0; j < m; ++j) {
+            const uint32_t i = moveActive_[j];
+            movePosX_[j] = k.posX[i];
+            movePosZ_[j] = k.posZ[i];
+            moveVelX_[j] = k.velX[i];
+            moveVelZ_[j] = k.velZ[i];
+            moveMaxSpeed_[j] = k.maxSpeed[i];
+        }
+        moveDirX_.resize(m);
+        moveDirZ_.resize(m);
+        moveDist_.resize(m);
+        moveSepX_.resize(m);
+        moveSepZ_.resize(m);
+        navigation_.SampleNearest(movePosX_, movePosZ_, moveDirX_, moveDirZ_, moveDist_);
+        ComputeSeparation(steering_, separationGrid_, moveActive_, k.posX, k.posY, k.posZ, moveSepX_, moveSepZ_);
+
+        // One update stands in for the tier's whole interval.
+        const float interval[3] = { 1.0f, static_cast<float>(std::max(lodConfig_.midInterval, 1)),
+                                    static_cast<float>(std::max(lodConfig_.farInterval, 1)) };
+        size_t begin = 0;
+        for (int t = 0; t < 3; ++t) {
+            const size_t end = tierEnd[t];
+            if (begin == end) continue;
+            const size_t len = end - begin;
+            const float dt = deltaSec * interval[t];
+            Span<float> velX(moveVelX_.data() + begin, len);
+            Span<float> velZ(moveVelZ_.data() + begin, len);
+            Span<const float> maxSpeed(moveMaxSpeed_.data() + begin, len);
+            SteerArrive(steering_, dt, Span<const float>(moveDirX_.data() + begin, len),
+                        Span<const float>(moveDirZ_.data() + begin, len),
+                        Span<const float>(moveDist_.data() + begin, len), maxSpeed, velX, velZ);
+            ApplyForce(steering_.separationWeight * dt, Span<const float>(moveSepX_.data() + begin, len),
+                       Span<const float>(moveSepZ_.data() + begin, len), maxSpeed, velX, velZ);
+            begin = end;
+        }
+        for (size_t j = 0; j < m; ++j) {
+            k.velX[moveActive_[j]] = moveVelX_[j];
+            k.velZ[moveActive_[j]] = moveVelZ_[j];
+        }
+    }
+
+    // Everyone moves every tick. Stop at walls rather than stepping into them
+    // (separation can push against the field, and coasting zombies do not
+    // re-read it).
+    const NavGrid& grid = navigation_.Grid();
+    if (grid.CellCount() > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            int32_t cell = grid.CellAt(k.posX[i] + k.velX[i] * deltaSec, k.posZ[i] + k.velZ[i] * deltaSec);
+            if (cell < 0 || !grid.Walkable(cell)) {
+                k.velX[i] = 0.0f;
+                k.velZ[i] = 0.0f;
+            }
+        }
+    }
+    Integrate(deltaSec, k.velX, k.velZ, k.posX, k.posZ);
+}
+
+void ZombiesMode::UpdateNavigationTargets() {
+    for (const auto& [id, ps] : players_) {
+        if (ps.alive && !ps.downed)
+            navigation_.SetTarget(id, ps.position);
+        else
+            navigation_.RemoveTarget(id);
+    }
+    navigation_.Update();
+}
+
+void ZombiesMode::SetPlayerPosition(PlayerId playerId, const Vec3& position) {
+    if (!IsFinite(position)) return;
+    auto it = players_.find(playerId);
+    if (it != players_.end())
+        it->second.position = position;
+}
+
+bool ZombiesMode::SetZombiePosition(uint32_t zombieId, const Vec3& position) {
+    return IsFinite(position) && zombies_.SetPosition(zombieId, position);
+}
+
+void ZombiesMode::RebuildSpatialIndex() {
+    gridIds_.clear();
+    for (size_t i = 0; i < zombies_.Size(); ++i)
+        gridIds_.push_back(zombies_.IdAt(i));
+    zombieGrid_.Build(gridIds_, zombies_.PosX(), zombies_.PosY(), zombies_.PosZ());
+
+    gridIds_.clear();
+    gridX_.clear();
+    gridY_.clear();
+    gridZ_.clear();
+    for (const auto& [id, ps] : players_) {
+        gridIds_.push_back(id);
+        gridX_.push_back(ps.position.x);
+        gridY_.push_back(ps.position.y);
+        gridZ_.push_back(ps.position.z);
+    }
+    playerGrid_.Build(gridIds_, gridX_, gridY_, gridZ_);
+}
+
+size_t ZombiesMode::QueryZombiesNearPlayer(PlayerId playerId, float radius, std::vector<uint32_t>& out) const {
+    auto it = players_.find(playerId);
+    if (it == players_.end()) return 0;
+    size_t first = out.size();
+    zombieGrid_.QueryRadius(it->second.position, radius, out);
+    out.erase(std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                             [&](uint32_t id) { return !zombies_.Contains(id); }),
+              out.end());
+    return out.size() - first;
+}
+
+size_t ZombiesMode::QueryPlayersInMeleeRange(uint32_t zombieId, std::vector<PlayerId>& out) const {
+    int64_t i = zombies_.IndexOf(zombieId);
+    if (i < 0) return 0;
+    size_t d = static_cast<size_t>(i);
+    Vec3 pos{ zombies_.PosX()[d], zombies_.PosY()[d], zombies_.PosZ()[d] };
+    size_t first = out.size();
+    playerGrid_.QueryRadius(pos, kZombieMeleeRange, out);
+    out.erase(std::remove_if(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                             [&](PlayerId id) {
+                                 auto ps = players_.find(id);
+                                 return ps == players_.end() || !ps->second.alive;
+                             }),
+              out.end());
+    return out.size() - first;
+}
+
 void ZombiesMode::CheckRoundComplete() {
     if (!roundState_.roundActive) return;
     if (roundState_.zombiesRemaining > 0) return;
@@ -131,20 +424,36 @@ void ZombiesMode::CheckRoundComplete() {
 }
 
 void ZombiesMode::OnZombieKilled(uint32_t zombieId, PlayerId killerId) {
-    const ZombieInstance* z = GetZombie(zombieId);
-    if (!z || !z->alive) return;
+    int64_t i = zombies_.IndexOf(zombieId);
+    if (i < 0) return;
+
+    KillZombie(zombieId, zombies_.Types()[static_cast<size_t>(i)], killerId);
+    CheckRoundComplete();
+}
 
-    int32_t points = PointsForZombie(z->type, roundState_.currentRound);
+int ZombiesMode::ApplyDamageBatch(Span<const ZombieHit> hits, std::vector<ZombieKillRecord>* killsOut) {
+    deaths_.clear();
+    zombies_.ApplyDamage(hits, deaths_);
+    for (const ZombieDeath& d : deaths_) {
+        ZombieKillRecord kill = KillZombie(d.zombieId, d.type, d.killerId);
+        if (killsOut) killsOut->push_back(kill);
+    }
+    if (!deaths_.empty())
+        CheckRoundComplete();
+    return static_cast<int>(deaths_.size());
+}
+
+ZombieKillRecord ZombiesMode::KillZombie(uint32_t zombieId, ZombieType type, PlayerId killerId) {
+    int32_t points = PointsForZombie(type, roundState_.currentRound);
     AddPoints(killerId, points);
 
-    zombies_.erase(zombieId);
+    zombies_.Erase(zombieId);
     roundState_.zombiesKilledThisRound++;
     roundState_.zombiesRemaining--;
 
     if (onZombieKill_)
-        onZombieKill_(killerId, zombieId, z->type, points);
-
-    CheckRoundComplete();
+        onZombieKill_(killerId, zombieId, type, points);
+    return ZombieKillRecord{ zombieId, killerId, type, points };
 }
 
 int32_t ZombiesMode::PointsForZombie(ZombieType type, int round) const {
@@ -191,16 +500,25 @@ bool ZombiesMode::SpendPoints(PlayerId playerId, int32_t cost) {
     return true;
 }
 
-const ZombieInstance* ZombiesMode::GetZombie(uint32_t zombieId) const {
-    auto it = zombies_.find(zombieId);
-    return it != zombies_.end() ? &it->second : nullptr;
+bool ZombiesMode::GetZombie(uint32_t zombieId, ZombieInstance& out) const {
+    int64_t i = zombies_.IndexOf(zombieId);
+    if (i < 0) return false;
+    size_t d = static_cast<size_t>(i);
+    out.id = zombieId;
+    out.type = zombies_.Types()[d];
+    out.health = zombies_.Health()[d];
+    out.maxHealth = zombies_.MaxHealth()[d];
+    out.position = Vec3{ zombies_.PosX()[d], zombies_.PosY()[d], zombies_.PosZ()[d] };
+    out.alive = (zombies_.Flags()[d] & kZombieAlive) != 0;
+    return true;
 }
 
 std::vector<ZombieInstance> ZombiesMode::GetAliveZombies() const {
     std::vector<ZombieInstance> out;
-    for (const auto& [id, z] : zombies_)
-        if (z.alive)
-            out.push_back(z);
+    out.reserve(zombies_.Size());
+    ForEachZombie([&](const ZombieRef& z) {
+        out.push_back(ZombieInstance{ z.Id(), z.Type(), z.Health(), z.MaxHealth(), z.Position(), true });
+    });
     return out;
 }
 
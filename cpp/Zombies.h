@@ -1,36 +1,85 @@
 #pragma once
 
 #include "GameTypes.h"
+#include "FlowField.h"
+#include "Span.h"
+#include "SpatialGrid.h"
+#include "Steering.h"
+#include "ZombieStore.h"
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <random>
 
 namespace game {
 
+inline constexpr float kZombieMeleeRange = 1.5f;
+inline constexpr float kZombieGridCellSize = 4.0f;
+
+// Copy of one zombie's components. Zombie ids are ZombieStore handles: ids of
+// dead zombies never resolve again.
 struct ZombieInstance {
     uint32_t id = 0;
     ZombieType type = ZombieType::Walker;
     float health = 100.0f;
     float maxHealth = 100.0f;
+    Vec3 position;
     bool alive = true;
 };
 
+struct ZombieKillRecord {
+    uint32_t zombieId = 0;
+    PlayerId killerId = 0;
+    ZombieType type = ZombieType::Walker;
+    int32_t points = 0;
+};
+
 struct ZombiesRoundState {
     int currentRound = 0;
     int zombiesSpawnedThisRound = 0;
     int zombiesKilledThisRound = 0;
-    int zombiesRemaining = 0;
+    int zombiesRemaining = 0;   // queued + alive
+    int zombiesQueued = 0;      // not spawned yet
     bool roundActive = false;
     bool roundComplete = false;
     float roundStartTime = 0.0f;
 };
 
+struct ZombieSpawnConfig {
+    int maxSpawnsPerTick = 4;
+    int maxAlive = 64;               // queued zombies wait while this many are up
+    float minSpawnDistance = 12.0f;  // spawn points are picked in this band
+    float maxSpawnDistance = 30.0f;  // around a random standing player
+};
+
+// AI level of detail: zombies steer every tick within nearDistance of the
+// nearest standing player, every midInterval ticks within midDistance and
+// every farInterval ticks beyond it (phases staggered by id). Skipped zombies
+// keep coasting on their last velocity; an update covers its whole interval.
+struct AiLodConfig {
+    bool enabled = true;
+    float nearDistance = 20.0f;
+    float midDistance = 50.0f;
+    int midInterval = 4;
+    int farInterval = 16;
+};
+
+// Counts from the last Tick.
+struct AiLodStats {
+    size_t nearCount = 0;
+    size_t midCount = 0;
+    size_t farCount = 0;
+    size_t updated = 0;  // zombies that steered this tick
+    size_t saved = 0;    // zombies that coasted instead
+};
+
 struct ZombiesPlayerState {
     PlayerId playerId = 0;
     int32_t points = 0;
     int32_t lives = 3;
     bool alive = true;
     bool downed = false;
+    Vec3 position;
 };
 
 class ZombiesMode {
@@ -38,7 +87,7 @@ public:
     using RoundEventCallback = std::function<void(int round, bool started)>;
     using ZombieKillCallback = std::function<void(PlayerId killerId, uint32_t zombieId, ZombieType type, int32_t points)>;
 
-    ZombiesMode() = default;
+    ZombiesMode();
 
     void Reset();
     void AddPlayer(PlayerId playerId);
@@ -47,32 +96,152 @@ public:
     void Tick(float deltaSec);
 
     void OnZombieKilled(uint32_t zombieId, PlayerId killerId);
+    // Applies a tick's hits in one pass; zombies brought to zero health are
+    // killed through the same points/round path as OnZombieKilled, credited to
+    // the hit that crossed zero. Kills are appended to killsOut when given.
+    int ApplyDamageBatch(Span<const ZombieHit> hits, std::vector<ZombieKillRecord>* killsOut = nullptr);
     void OnPlayerDowned(PlayerId playerId);
     void OnPlayerRevived(PlayerId playerId);
     void OnPlayerDied(PlayerId playerId);
 
+    // ---- Spawning ----
+    // StartRound queues the wave (per-type counts only); Tick releases up to
+    // maxSpawnsPerTick while fewer than maxAlive are up, at spawn points in
+    // the distance band around a random standing player (or on a ring around
+    // them when no spawn point fits).
+    void SetSpawnConfig(const ZombieSpawnConfig& config);
+    const ZombieSpawnConfig& GetSpawnConfig() const { return spawnConfig_; }
+    void SetSpawnPoints(Span<const Vec3> points) { spawnPoints_.assign(points.begin(), points.end()); }
+    // Adds a wave's zombies to the current round's queue (StartRound queues
+    // GetWaveConfig(round); scripted or custom waves can add more). Queued
+    // zombies spawn with the latest wave's health multiplier.
+    void QueueWave(const ZombieWaveConfig& wave);
+
+    // ---- Positions and proximity ----
+    // Queries run against grids rebuilt at the start of each Tick (or by
+    // RebuildSpatialIndex), so positions set since then are not seen yet;
+    // zombies killed since then are filtered out. Non-finite positions are
+    // ignored (SetZombiePosition returns false) and non-finite radii match
+    // nothing.
+    void SetPlayerPosition(PlayerId playerId, const Vec3& position);
+    bool SetZombiePosition(uint32_t zombieId, const Vec3& position);
+    void RebuildSpatialIndex();
+    // Appends ids of zombies within radius of the player; returns how many.
+    size_t QueryZombiesNearPlayer(PlayerId playerId, float radius, std::vector<uint32_t>& out) const;
+    // Appends alive players within kZombieMeleeRange of the zombie; returns how many.
+    size_t QueryPlayersInMeleeRange(uint32_t zombieId, std::vector<PlayerId>& out) const;
+
+    // ---- Navigation ----
+    // Alive, standing players are flow-field targets; their fields are
+    // refreshed in Tick within the FlowFieldSet rebuild budget.
+    void SetNavGrid(NavGrid grid) { navigation_.SetGrid(std::move(grid)); }
+    const FlowFieldSet& Navigation() const { return navigation_; }
+    // Zombies follow the nearest player's field (arrive, stopping at melee
+    // range) with separation from neighbours; advanced every Tick.
+    void SetSteeringParams(const SteeringParams& params) {
+        steering_ = params;
+        separationGrid_ = SpatialGrid(2.0f * params.separationRadius);
+    }
+    const SteeringParams& GetSteeringParams() const { return steering_; }
+    void SetAiLodConfig(const AiLodConfig& config) { lodConfig_ = config; }
+    const AiLodConfig& GetAiLodConfig() const { return lodConfig_; }
+    const AiLodStats& GetAiLodStats() const { return lodStats_; }
+
     void AddPoints(PlayerId playerId, int32_t points);
     bool SpendPoints(PlayerId playerId, int32_t cost);
 
     const ZombiesRoundState& GetRoundState() const { return roundState_; }
-    const ZombieInstance* GetZombie(uint32_t zombieId) const;
+    bool GetZombie(uint32_t zombieId, ZombieInstance& out) const;
+    // Copies every alive zombie; per-tick readers should use ForEachZombie.
     std::vector<ZombieInstance> GetAliveZombies() const;
+    const ZombieStore& Store() const { return zombies_; }
     const ZombiesPlayerState* GetPlayerState(PlayerId playerId) const;
+
+    // ---- Views ----
+    // Visit state in place, without allocating or copying. fn(ZombieRef) is
+    // called for each alive zombie in dense order, fn(const
+    // ZombiesPlayerState&) for each player; the filter overloads skip entries
+    // the predicate rejects. The mode must not be modified from inside fn.
+    template <typename Fn>
+    void ForEachZombie(Fn&& fn) const {
+        ForEachZombie([](const ZombieRef&) { return true; }, fn);
+    }
+    template <typename Filter, typename Fn>
+    void ForEachZombie(Filter&& keep, Fn&& fn) const {
+        Span<const uint8_t> flags = zombies_.Flags();
+        for (size_t i = 0; i < flags.size(); ++i) {
+            if (!(flags[i] & kZombieAlive)) continue;
+            ZombieRef z = zombies_.At(i);
+            if (keep(z)) fn(z);
+        }
+    }
+    template <typename Fn>
+    void ForEachPlayer(Fn&& fn) const {
+        for (const auto& [id, ps] : players_) fn(ps);
+    }
+    template <typename Filter, typename Fn>
+    void ForEachPlayer(Filter&& keep, Fn&& fn) const {
+        for (const auto& [id, ps] : players_)
+            if (keep(ps)) fn(ps);
+    }
     ZombieWaveConfig GetWaveConfig(int round) const;
 
     void SetRoundEventCallback(RoundEventCallback cb) { onRoundEvent_ = std::move(cb); }
     void SetZombieKillCallback(ZombieKillCallback cb) { onZombieKill_ = std::move(cb); }
 
 private:
-    void SpawnWave();
-    void SpawnZombie(ZombieType type, float healthMultiplier);
+    void ReleaseSpawns();
+    bool SpawnZombie(ZombieType type, float healthMultiplier, const Vec3& position);
+    Vec3 PickSpawnPosition();
     int32_t PointsForZombie(ZombieType type, int round) const;
+    ZombieKillRecord KillZombie(uint32_t zombieId, ZombieType type, PlayerId killerId);
     void CheckRoundComplete();
+    void UpdateNavigationTargets();
+    void MoveZombies(float deltaSec);
+    void ScheduleAiLod(size_t tierEnd[3]);
 
-    uint32_t nextZombieId_ = 1;
     ZombiesRoundState roundState_;
+    ZombieSpawnConfig spawnConfig_;
+    std::vector<Vec3> spawnPoints_;
+    int queued_[kZombieTypeCount] = {};  // per ZombieType
+    float queuedHealthMultiplier_ = 1.0f;
+    uint8_t nextSpawnType_ = 0;
+    static constexpr uint32_t kSpawnSeed = 0x5eedu;  // every match replays the same spawn sequence
+    std::minstd_rand spawnRng_{ kSpawnSeed };
     std::unordered_map<PlayerId, ZombiesPlayerState> players_;
-    std::unordered_map<uint32_t, ZombieInstance> zombies_;
+    ZombieStore zombies_;
+    std::vector<ZombieDeath> deaths_;  // ApplyDamageBatch scratch
+
+    FlowFieldSet navigation_;
+    SteeringParams steering_;
+    SpatialGrid separationGrid_;
+    AiLodConfig lodConfig_;
+    AiLodStats lodStats_;
+    uint32_t lodTick_ = 0;
+    // MoveZombies scratch. moveIndex_ is per zombie; the rest hold the
+    // zombies steering this tick (moveActive_, near tier first), gathered.
+    std::vector<uint32_t> moveIndex_;
+    std::vector<uint8_t> moveTier_;
+    std::vector<uint32_t> moveActive_;
+    std::vector<float> movePosX_;
+    std::vector<float> movePosZ_;
+    std::vector<float> moveVelX_;
+    std::vector<float> moveVelZ_;
+    std::vector<float> moveMaxSpeed_;
+    std::vector<float> moveDirX_;
+    std::vector<float> moveDirZ_;
+    std::vector<float> moveDist_;
+    std::vector<float> moveSepX_;
+    std::vector<float> moveSepZ_;
+    std::vector<float> lodPlayerX_;
+    std::vector<float> lodPlayerZ_;
+    SpatialGrid zombieGrid_{ kZombieGridCellSize };
+    SpatialGrid playerGrid_{ kZombieGridCellSize };
+    // RebuildSpatialIndex scratch.
+    std::vector<uint32_t> gridIds_;
+    std::vector<float> gridX_;
+    std::vector<float> gridY_;
+    std::vector<float> gridZ_;
     RoundEventCallback onRoundEvent_;
     ZombieKillCallback onZombieKill_;
 };
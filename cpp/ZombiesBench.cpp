@@ -0,0 +1,175 @@
+/**
+ * Virtual Sim — Zombies scaling benchmark
+ * Holds a horde of N zombies (100, 1k, 10k, 100k) chasing four moving players
+ * across an open nav grid, and per tick lands a spread of hits (some lethal),
+ * kills a few directly and streams replacements in. Reports per horde size,
+ * as JSON: ns per zombie per tick, heap allocations per tick and the process
+ * peak resident memory so far.
+ *
+ * Usage: zombies_bench [--ticks N] [--max N]
+ */
+
+#include "BenchSupport.h"
+#include "Zombies.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace game;
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    int zombies = 0;
+    int ticks = 0;
+    double nsPerZombieTick = 0.0;
+    double allocsPerTick = 0.0;
+    double allocBytesPerTick = 0.0;
+    double killsPerTick = 0.0;
+    double aiUpdatesSavedPerTick = 0.0;
+    uint64_t peakRssKb = 0;
+};
+
+static constexpr float kTickSec = 1.0f / 60.0f;
+static constexpr int kPlayers = 4;
+
+static BenchResult RunHorde(int zombies, int ticks, std::mt19937& rng) {
+    ZombiesMode mode;
+
+    // Open square map at ~8 m^2 per zombie, 1 m cells.
+    const int32_t side = std::max(64, static_cast<int32_t>(std::ceil(std::sqrt(zombies * 8.0))));
+    const float extent = static_cast<float>(side);
+    mode.SetNavGrid(NavGrid(side, side, 1.0f));
+
+    std::uniform_real_distribution<float> coord(1.0f, extent - 1.0f);
+    std::vector<Vec3> spawnPoints(1024);
+    for (Vec3& p : spawnPoints) p = Vec3{ coord(rng), 0.0f, coord(rng) };
+    mode.SetSpawnPoints(spawnPoints);
+
+    ZombieSpawnConfig spawn;
+    spawn.maxAlive = zombies;
+    spawn.maxSpawnsPerTick = zombies;
+    spawn.minSpawnDistance = 0.0f;
+    spawn.maxSpawnDistance = 2.0f * extent;
+    mode.SetSpawnConfig(spawn);
+
+    for (PlayerId p = 1; p <= kPlayers; ++p) mode.AddPlayer(p);
+    // Players circle the map centre at ~6 m/s, a quarter turn apart.
+    const float radius = 0.3f * extent;
+    const float radPerTick = 6.0f * kTickSec / radius;
+    auto movePlayers = [&](int tick) {
+        for (PlayerId p = 1; p <= kPlayers; ++p) {
+            float a = radPerTick * static_cast<float>(tick) + 1.5708f * static_cast<float>(p);
+            mode.SetPlayerPosition(p, Vec3{ 0.5f * extent + radius * std::cos(a), 0.0f,
+                                            0.5f * extent + radius * std::sin(a) });
+        }
+    };
+
+    // Refills keep the queue ahead of kills; Walker-heavy like a normal wave.
+    auto refill = [&](int count) {
+        ZombieWaveConfig wave;
+        wave.walkerCount = count * 7 / 10;
+        wave.runnerCount = count / 4;
+        wave.bruteCount = count - wave.walkerCount - wave.runnerCount;
+        mode.QueueWave(wave);
+    };
+
+    movePlayers(0);
+    mode.StartRound();
+    refill(zombies);
+    mode.Tick(kTickSec);
+    for (int t = 1; t <= 30; ++t) {  // warm up: fields built, scratch grown
+        movePlayers(t);
+        mode.Tick(kTickSec);
+    }
+
+    // Per tick: hits on ~5% of the horde (a fifth of them lethal) plus ~0.2%
+    // killed outright; the spawn budget lets replacements stream back in.
+    spawn.maxSpawnsPerTick = std::max(4, zombies / 50);
+    mode.SetSpawnConfig(spawn);
+    const int hitsPerTick = std::max(1, zombies / 20);
+    const int directKillsPerTick = std::max(1, zombies / 500);
+    std::vector<ZombieHit> hits;
+    std::vector<ZombieKillRecord> kills;
+    hits.reserve(static_cast<size_t>(hitsPerTick));
+    kills.reserve(static_cast<size_t>(hitsPerTick + directKillsPerTick));
+    std::uniform_real_distribution<float> damage(10.0f, 60.0f);
+
+    uint64_t killCount = 0;
+    uint64_t savedUpdates = 0;
+    double totalNs = 0.0;
+    double zombieTicks = 0.0;
+    const uint64_t allocCount0 = g_allocCount.load();
+    const uint64_t allocBytes0 = g_allocBytes.load();
+
+    for (int t = 0; t < ticks; ++t) {
+        movePlayers(31 + t);
+        const ZombieStore& store = mode.Store();
+        const size_t alive = store.Size();
+        zombieTicks += static_cast<double>(alive);
+        hits.clear();
+        kills.clear();
+        std::uniform_int_distribution<size_t> pick(0, alive ? alive - 1 : 0);
+        for (int h = 0; h < hitsPerTick && alive > 0; ++h) {
+            PlayerId attacker = static_cast<PlayerId>(1 + h % kPlayers);
+            hits.push_back(ZombieHit{ store.IdAt(pick(rng)), attacker, h % 5 == 0 ? 1.0e6f : damage(rng) });
+        }
+
+        auto start = Clock::now();
+        mode.ApplyDamageBatch(hits, &kills);
+        for (int k = 0; k < directKillsPerTick && mode.Store().Size() > 0; ++k)
+            mode.OnZombieKilled(mode.Store().IdAt(0), 1);
+        if (mode.GetRoundState().zombiesQueued < zombies / 4 + 1) refill(zombies / 2 + 1);
+        mode.Tick(kTickSec);
+        totalNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        killCount += kills.size() + static_cast<uint64_t>(directKillsPerTick);
+        savedUpdates += mode.GetAiLodStats().saved;
+    }
+
+    BenchResult r;
+    r.zombies = zombies;
+    r.ticks = ticks;
+    r.nsPerZombieTick = zombieTicks > 0.0 ? totalNs / zombieTicks : 0.0;
+    r.allocsPerTick = static_cast<double>(g_allocCount.load() - allocCount0) / ticks;
+    r.allocBytesPerTick = static_cast<double>(g_allocBytes.load() - allocBytes0) / ticks;
+    r.killsPerTick = static_cast<double>(killCount) / ticks;
+    r.aiUpdatesSavedPerTick = static_cast<double>(savedUpdates) / ticks;
+    r.peakRssKb = PeakRssKb();
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int ticks = 0;  // 0 = scale with horde size
+    int maxZombies = 100000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--ticks") == 0) ticks = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--max") == 0) maxZombies = std::atoi(argv[i + 1]);
+    }
+
+    std::mt19937 rng(42);
+    std::vector<BenchResult> results;
+    // Ascending, so each peak RSS covers the largest horde run so far.
+    for (int n : { 100, 1000, 10000, 100000 }) {
+        if (n > maxZombies) break;
+        int t = ticks > 0 ? ticks : std::clamp(2000000 / n, 50, 2000);
+        results.push_back(RunHorde(n, t, rng));
+    }
+
+    std::printf("{\"tickSec\":%.6f,\"players\":%d,\"results\":[", kTickSec, kPlayers);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::printf("%s\n  {\"zombies\":%d,\"ticks\":%d,\"nsPerZombieTick\":%.1f,\"allocsPerTick\":%.2f,"
+                    "\"allocBytesPerTick\":%.1f,\"killsPerTick\":%.1f,\"aiUpdatesSavedPerTick\":%.1f,"
+                    "\"peakRssKb\":%llu}",
+                    i ? "," : "", r.zombies, r.ticks, r.nsPerZombieTick, r.allocsPerTick, r.allocBytesPerTick,
+                    r.killsPerTick, r.aiUpdatesSavedPerTick, static_cast<unsigned long long>(r.peakRssKb));
+    }
+    std::printf("\n]}\n");
+    return 0;
+}